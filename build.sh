@@ -43,14 +43,24 @@ else
   echo "Building without Perfetto tracing (set ENABLE_PERFETTO=1 to enable)..."
 fi
 
+ENABLE_WASM_SIMD_FLAG="${ENABLE_WASM_SIMD:-0}"
+if [[ "$ENABLE_WASM_SIMD_FLAG" == "1" ]]; then
+  echo "Building the snapshot diff with wasm SIMD128 (requires a SIMD-capable engine)..."
+fi
+
 # Build C/C++ object files first (uses Makefile)
-run emmake make -j8 ENABLE_PERFETTO="$ENABLE_PERFETTO_FLAG"
+run emmake make -j8 ENABLE_PERFETTO="$ENABLE_PERFETTO_FLAG" ENABLE_WASM_SIMD="$ENABLE_WASM_SIMD_FLAG"
 
 # Exported functions (C symbols must be prefixed with underscore)
 # IMPORTANT: keep this list sorted lexicographically; one symbol per line.
 exported_functions=(
   _add_pc_hook_addr
+  _add_banked_region
+  _add_mirror_region
+  _add_mmio_region
   _add_region
+  _add_region_swapped
+  _add_rom_region
   _clear_instr_hook_func
   _clear_pc_hook_addrs
   _clear_pc_hook_func
@@ -59,29 +69,118 @@ exported_functions=(
   _enable_printf_logging
   _free
   _get_function_name
+  _get_last_unmapped_access
   _get_memory_name
+  _get_region_dirty_pages
+  _get_region_wait_cycles
   _malloc
+  _m68k_bridge_slow_pages
+  _m68k_bridge_stats_ptr
+  _m68k_bridge_stats_reset
+  _m68k_bridge_track_slow_pages
   _m68k_call_until_js_stop
+  _m68k_callstack_clear
+  _m68k_callstack_depth
+  _m68k_callstack_restore
   _m68k_cycles_run
+  _m68k_diff_impl_in_use
+  _m68k_diff_memory
+  _m68k_diff_regs
+  _m68k_dirty_clear
+  _m68k_dirty_count
+  _m68k_dirty_enable
+  _m68k_dirty_get_and_clear
+  _m68k_dirty_page_shift
   _m68k_disassemble
   _m68k_end_timeslice
   _m68k_execute
   _m68k_fault_clear
   _m68k_fault_record_ptr
+  _m68k_fingerprint_break_at
+  _m68k_fingerprint_count
+  _m68k_fingerprint_current
+  _m68k_fingerprint_data
+  _m68k_fingerprint_disable
+  _m68k_fingerprint_enable
+  _m68k_fingerprint_find_divergence
+  _m68k_fingerprint_instructions
+  _m68k_fingerprint_interval
+  _m68k_fingerprint_is_enabled
+  _m68k_get_address_width
+  _m68k_get_all_regs
+  _m68k_get_backtrace
+  _m68k_get_backtrace_frames
   _m68k_get_last_break_reason
   _m68k_get_reg
   _m68k_get_total_cycles
+  _m68k_history_clear
+  _m68k_history_ptr
+  _m68k_history_set_pc_tracking
+  _m68k_hookcost_enable
+  _m68k_hookcost_pc_ptr
+  _m68k_hookcost_reset
+  _m68k_hookcost_stats_ptr
+  _m68k_hookcost_top_pcs
   _m68k_init
+  _m68k_irqlat_reset
+  _m68k_irqlat_stats_ptr
+  _m68k_memo_disable
+  _m68k_memo_disable_all
+  _m68k_memo_enable
+  _m68k_memo_invalidate
+  _m68k_memo_invalidate_all
+  _m68k_memo_invalidate_range
+  _m68k_memo_reset_stats
+  _m68k_memo_stats_ptr
   _m68k_pulse_reset
   _m68k_regnum_from_name
+  _m68k_replay_diverged
+  _m68k_replay_event_count
+  _m68k_replay_finished
+  _m68k_replay_get_mode
+  _m68k_replay_log_data
+  _m68k_replay_log_size
+  _m68k_replay_position
+  _m68k_replay_start_playback
+  _m68k_replay_start_recording
+  _m68k_replay_stop
   _m68k_reset_last_break_reason
   _m68k_reset_total_cycles
+  _m68k_set_address_width
+  _m68k_set_all_regs
   _m68k_set_context
   _m68k_set_reg
+  _m68k_set_total_cycles
   _m68k_set_trace_flow_callback
   _m68k_set_trace_instr_callback
   _m68k_set_trace_mem_callback
+  _m68k_stack_add_region
+  _m68k_stack_clear_regions
+  _m68k_stack_region_ptr
+  _m68k_stack_reset_marks
+  _m68k_stack_take_guard_hit
   _m68k_step_one
+  _m68k_timetravel_add_breakpoint
+  _m68k_timetravel_add_watchpoint
+  _m68k_timetravel_checkpoint
+  _m68k_timetravel_checkpoint_count
+  _m68k_timetravel_clear_breakpoints
+  _m68k_timetravel_clear_watchpoints
+  _m68k_timetravel_cycle
+  _m68k_timetravel_disable
+  _m68k_timetravel_enable
+  _m68k_timetravel_export_segment
+  _m68k_timetravel_free_segment
+  _m68k_timetravel_is_enabled
+  _m68k_timetravel_load_segment
+  _m68k_timetravel_position
+  _m68k_timetravel_present
+  _m68k_timetravel_reverse_continue
+  _m68k_timetravel_reverse_step
+  _m68k_timetravel_run_segment
+  _m68k_timetravel_seek
+  _m68k_timetravel_seek_cycle
+  _m68k_timetravel_segment_count
   _m68k_trace_add_mem_region
   _m68k_trace_clear_mem_regions
   _m68k_trace_enable
@@ -90,18 +189,31 @@ exported_functions=(
   _m68k_trace_set_instr_enabled
   _m68k_trace_set_mem_enabled
   _my_initialize
+  _read_block
   _register_function_name
   _register_memory_name
   _register_memory_range
+  _remap_bank
+  _remove_region
   _reset_myfunc_state
+  _reset_wait_cycles
   _set_entry_point
   _set_full_instr_hook_func
+  _set_open_bus_value
   _set_pc_hook_func
   _set_read_mem_func
   _set_write_mem_func
+  _set_read16_callback
+  _set_read32_callback
   _set_read8_callback
+  _set_write16_callback
+  _set_write32_callback
   _set_write8_callback
   _set_probe_callback
+  _set_region_wait_states
+  _set_unmapped_default
+  _set_unmapped_policy
+  _write_block
 )
 
 # Add Perfetto-only exports when enabled (parity with Fish)
@@ -112,6 +224,7 @@ if [[ "$ENABLE_PERFETTO_FLAG" == "1" ]]; then
     _m68k_perfetto_enable_flow
     _m68k_perfetto_enable_instructions
     _m68k_perfetto_enable_instruction_registers
+    _m68k_perfetto_enable_interrupts
     _m68k_perfetto_enable_memory
     _m68k_perfetto_export_trace
     _m68k_perfetto_free_trace_data
@@ -149,7 +262,7 @@ EXPORTED_FUNCTIONS_LIST=$(to_ems_list "${exported_functions[@]}")
 DEFAULT_LIBS_LIST=$(to_ems_list "${default_lib_funcs[@]}")
 RUNTIME_METHODS_LIST=$(to_ems_list "${runtime_methods[@]}")
 
-object_files=(m68kcpu.o m68kops.o musashi_fault.o myfunc.o m68k_memory_bridge.o m68ktrace.o m68kdasm.o)
+object_files=(m68kcpu.o m68kops.o musashi_fault.o myfunc.o m68k_memory_bridge.o m68ktrace.o m68k_replay.o m68k_timetravel.o m68k_memo.o m68k_fingerprint.o m68k_callstack.o m68k_stackwatch.o m68k_irqlat.o m68k_hookcost.o m68k_bridgestats.o m68k_pagemap.o m68k_dirty.o m68k_diff.o m68kdasm.o)
 if [[ "$ENABLE_PERFETTO_FLAG" == "1" ]]; then
   object_files+=(m68k_perfetto.o third_party/retrobus-perfetto/cpp/proto/perfetto.pb.o)
 fi
@@ -208,6 +208,14 @@ void m68k_write_memory_32(unsigned int address, unsigned int value);
  */
 void m68k_write_memory_32_pd(unsigned int address, unsigned int value);
 
+/* MOVEM block transfers: host memory holding count big-endian accesses of
+ * size bytes from address, if the memory system can serve the whole run
+ * at once and account for every access itself; NULL makes the CPU fall
+ * back to one read/write call per access.
+ */
+const unsigned char* m68k_movem_read_span(unsigned int address, unsigned int count, unsigned int size);
+unsigned char* m68k_movem_write_span(unsigned int address, unsigned int count, unsigned int size);
+
 
 
 /* ======================================================================== */
@@ -329,6 +337,7 @@ int m68k_execute(int num_cycles);
 int m68k_cycles_run(void);              /* Number of cycles run so far */
 int m68k_cycles_remaining(void);        /* Number of cycles left */
 void m68k_modify_timeslice(int cycles); /* Modify cycles left */
+void m68k_use_cycles(int cycles);       /* Consume cycles (bus wait states) */
 void m68k_end_timeslice(void);          /* End timeslice now */
 
 /* Set the IPL0-IPL2 pins on the CPU (IRQ).
@@ -376,6 +385,15 @@ unsigned int m68k_get_reg(void* context, m68k_register_t reg);
 /* Poke values into the internals of the currently running CPU context */
 void m68k_set_reg(m68k_register_t reg, unsigned int value);
 
+/* Copy D0-D7, A0-A7, PC, SR, SP and PPC of the running context to or from
+ * regs[M68K_REG_D0 .. M68K_REG_PPC] in one call, with the same values
+ * m68k_get_reg / m68k_set_reg would use. The SP entry mirrors A7 and is
+ * ignored on set.
+ */
+#define M68K_ALL_REGS_COUNT (M68K_REG_PPC + 1)
+void m68k_get_all_regs(unsigned int* regs);
+void m68k_set_all_regs(const unsigned int* regs);
+
 /* Check if an instruction is valid for the specified CPU type */
 unsigned int m68k_is_valid_instruction(unsigned int instruction, unsigned int cpu_type);
 
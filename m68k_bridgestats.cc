@@ -0,0 +1,80 @@
+/* ======================================================================== */
+/* ===================== M68K MEMORY BRIDGE STATISTICS =================== */
+/* ======================================================================== */
+
+#include "m68k_bridgestats.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+m68k_bridge_stats_t m68k_bridge_stats = {};
+int m68k_bridge_page_shift = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+/* Page index -> slow-path accesses */
+std::unordered_map<uint32_t, uint32_t> g_slow_pages;
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+m68k_bridge_stats_t* m68k_bridge_stats_ptr(void)
+{
+    return &m68k_bridge_stats;
+}
+
+void m68k_bridge_stats_reset(void)
+{
+    m68k_bridge_stats = m68k_bridge_stats_t{};
+    g_slow_pages.clear();
+}
+
+int m68k_bridge_track_slow_pages(int page_shift)
+{
+    if (page_shift != 0 && (page_shift < 8 || page_shift > 24)) {
+        return -1;
+    }
+    m68k_bridge_page_shift = page_shift;
+    g_slow_pages.clear();
+    return 0;
+}
+
+int m68k_bridge_slow_pages(uint32_t* pages, uint32_t* counts, int max)
+{
+    if (!pages || !counts || max <= 0) {
+        return 0;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> ranked(g_slow_pages.begin(), g_slow_pages.end());
+    const size_t count = std::min(ranked.size(), static_cast<size_t>(max));
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    for (size_t i = 0; i < count; ++i) {
+        pages[i] = ranked[i].first << m68k_bridge_page_shift;
+        counts[i] = ranked[i].second;
+    }
+    return static_cast<int>(count);
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+void m68k_bridge_note_slow_page(uint32_t address)
+{
+    g_slow_pages[address >> m68k_bridge_page_shift]++;
+}
+
+} // extern "C"
@@ -0,0 +1,82 @@
+/* ======================================================================== */
+/* ===================== M68K MEMORY BRIDGE STATISTICS =================== */
+/* ======================================================================== */
+
+#ifndef M68KBRIDGESTATS__HEADER
+#define M68KBRIDGESTATS__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Which handler served an access; doubles as the class of the page it hit */
+typedef enum {
+    M68K_BRIDGE_PATH_REGION = 0,    /* Native RAM / ROM region */
+    M68K_BRIDGE_PATH_MMIO,          /* Native MMIO handler region */
+    M68K_BRIDGE_PATH_REPLAY,        /* Replay log during playback */
+    M68K_BRIDGE_PATH_JS,            /* js_read* / js_write* callbacks */
+    M68K_BRIDGE_PATH_LEGACY,        /* set_read_mem_func / set_write_mem_func */
+    M68K_BRIDGE_PATH_NONE,          /* Unmapped, or write dropped (replay, ROM) */
+    M68K_BRIDGE_PATH_COUNT
+} m68k_bridge_path;
+
+/* Access counts indexed [path][size] with size index 0/1/2 for
+ * byte/word/long (all fields uint32 for easy HEAPU32 access) */
+typedef struct m68k_bridge_stats {
+    uint32_t reads[M68K_BRIDGE_PATH_COUNT][3];
+    uint32_t writes[M68K_BRIDGE_PATH_COUNT][3];
+    uint32_t fetches[3];            /* Instruction stream reads (also in reads) */
+} m68k_bridge_stats_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Counters are always on (one increment per access). The slow-path page
+ * histogram is opt-in and counts JS, legacy and unmapped accesses per
+ * (address >> page_shift), showing which holes in the region layout send
+ * accesses to the host. */
+
+m68k_bridge_stats_t* m68k_bridge_stats_ptr(void);
+void m68k_bridge_stats_reset(void);
+
+/* page_shift 8-24 enables the histogram (and clears it), 0 disables */
+int m68k_bridge_track_slow_pages(int page_shift);
+
+/* Up to max pages, busiest first: page base addresses and their slow-path
+ * access counts. Returns count. */
+int m68k_bridge_slow_pages(uint32_t* pages, uint32_t* counts, int max);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the memory bridge - not part of public API */
+
+extern m68k_bridge_stats_t m68k_bridge_stats;
+extern int m68k_bridge_page_shift;
+
+void m68k_bridge_note_slow_page(uint32_t address);
+
+static inline void m68k_bridge_note_read(m68k_bridge_path path, int size, uint32_t address)
+{
+    m68k_bridge_stats.reads[path][size >> 1]++;
+    if (path >= M68K_BRIDGE_PATH_JS && m68k_bridge_page_shift) {
+        m68k_bridge_note_slow_page(address);
+    }
+}
+
+static inline void m68k_bridge_note_write(m68k_bridge_path path, int size, uint32_t address)
+{
+    m68k_bridge_stats.writes[path][size >> 1]++;
+    if (path >= M68K_BRIDGE_PATH_JS && m68k_bridge_page_shift) {
+        m68k_bridge_note_slow_page(address);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KBRIDGESTATS__HEADER */
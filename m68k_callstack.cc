@@ -0,0 +1,140 @@
+/* ======================================================================== */
+/* ======================= M68K SHADOW CALL STACK ======================== */
+/* ======================================================================== */
+
+#include "m68k_callstack.h"
+#include "m68kcpu.h"
+#include <cstdint>
+#include <cstring>
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+struct m68k_callstack_state {
+    m68k_callstack_frame_t frames[M68K_CALLSTACK_MAX_DEPTH];
+    int depth = 0;
+};
+
+m68k_callstack_state g_cs;
+
+/* Index of the active stack pointer in REG_SP_BASE */
+inline uint32_t active_stack() noexcept
+{
+    return FLAG_S | ((FLAG_S >> 1) & FLAG_M);
+}
+
+inline uint32_t stack_pointer(uint32_t stack) noexcept
+{
+    return stack == active_stack() ? REG_SP : REG_SP_BASE[stack];
+}
+
+/* Frames whose stack has been unwound past them are dead */
+void drop_dead_frames() noexcept
+{
+    while (g_cs.depth > 0) {
+        const m68k_callstack_frame_t& top = g_cs.frames[g_cs.depth - 1];
+        if (stack_pointer(top.stack) <= top.sp) {
+            break;
+        }
+        --g_cs.depth;
+    }
+}
+
+void push_frame(uint32_t return_addr, uint32_t target, uint32_t kind) noexcept
+{
+    drop_dead_frames();
+    /* A push at or above an existing frame on the same stack overwrote it */
+    while (g_cs.depth > 0) {
+        const m68k_callstack_frame_t& top = g_cs.frames[g_cs.depth - 1];
+        if (top.stack != active_stack() || top.sp > REG_SP) {
+            break;
+        }
+        --g_cs.depth;
+    }
+    if (g_cs.depth == M68K_CALLSTACK_MAX_DEPTH) {
+        std::memmove(&g_cs.frames[0], &g_cs.frames[1],
+                     sizeof(g_cs.frames[0]) * (M68K_CALLSTACK_MAX_DEPTH - 1));
+        --g_cs.depth;
+    }
+    m68k_callstack_frame_t& frame = g_cs.frames[g_cs.depth++];
+    frame.return_addr = return_addr;
+    frame.target = target;
+    frame.sp = REG_SP;
+    frame.cycle = static_cast<uint32_t>(m68k_history_clock());
+    frame.kind = kind;
+    frame.stack = active_stack();
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_get_backtrace(uint32_t* buf, int max)
+{
+    drop_dead_frames();
+    int count = 0;
+    for (int i = g_cs.depth - 1; i >= 0 && count < max; --i) {
+        buf[count++] = g_cs.frames[i].return_addr;
+    }
+    return count;
+}
+
+int m68k_get_backtrace_frames(m68k_callstack_frame_t* buf, int max)
+{
+    drop_dead_frames();
+    int count = 0;
+    for (int i = g_cs.depth - 1; i >= 0 && count < max; --i) {
+        buf[count++] = g_cs.frames[i];
+    }
+    return count;
+}
+
+int m68k_callstack_depth(void)
+{
+    drop_dead_frames();
+    return g_cs.depth;
+}
+
+void m68k_callstack_clear(void)
+{
+    g_cs.depth = 0;
+}
+
+void m68k_callstack_restore(const m68k_callstack_frame_t* frames, int count)
+{
+    if (count > M68K_CALLSTACK_MAX_DEPTH) {
+        count = M68K_CALLSTACK_MAX_DEPTH;
+    }
+    g_cs.depth = count > 0 ? count : 0;
+    for (int i = 0; i < g_cs.depth; ++i) {
+        g_cs.frames[i] = frames[g_cs.depth - 1 - i];
+    }
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+void m68k_callstack_call(uint32_t return_addr, uint32_t target)
+{
+    push_frame(return_addr, target, M68K_CALLSTACK_CALL);
+}
+
+void m68k_callstack_exception(uint32_t return_addr, uint32_t target)
+{
+    push_frame(return_addr, target, M68K_CALLSTACK_EXCEPTION);
+}
+
+void m68k_callstack_return(void)
+{
+    drop_dead_frames();
+}
+
+} // extern "C"
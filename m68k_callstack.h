@@ -0,0 +1,70 @@
+/* ======================================================================== */
+/* ======================= M68K SHADOW CALL STACK ======================== */
+/* ======================================================================== */
+
+#ifndef M68KCALLSTACK__HEADER
+#define M68KCALLSTACK__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Deepest stack kept; deeper calls drop the outermost frames */
+#define M68K_CALLSTACK_MAX_DEPTH 256
+
+typedef enum {
+    M68K_CALLSTACK_CALL = 0,        /* BSR, JSR */
+    M68K_CALLSTACK_EXCEPTION = 1    /* Exception or interrupt entry */
+} m68k_callstack_kind;
+
+/* One shadow frame (all fields uint32 for easy HEAPU32 access) */
+typedef struct m68k_callstack_frame {
+    uint32_t return_addr;   /* Where execution resumes when the frame returns */
+    uint32_t target;        /* Subroutine or handler entry point */
+    uint32_t sp;            /* Stack address of the return address / exception frame */
+    uint32_t cycle;         /* Low 32 bits of the history cycle clock at entry */
+    uint32_t kind;          /* m68k_callstack_kind */
+    uint32_t stack;         /* Stack holding the frame: 0 USP, 4 ISP, 6 MSP */
+} m68k_callstack_frame_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* The core pushes a frame on every BSR/JSR and exception entry and pops on
+ * RTS/RTE. A frame is also dropped as soon as its stack pointer has moved
+ * above it, which resynchronises after longjmp-style SP resets, RTR/RTD and
+ * hand-rolled returns without any guest memory reads. */
+
+/* Copy up to max return addresses, innermost first. Returns the count. */
+int m68k_get_backtrace(uint32_t* buf, int max);
+
+/* Same, with full frame records */
+int m68k_get_backtrace_frames(m68k_callstack_frame_t* buf, int max);
+
+int m68k_callstack_depth(void);
+void m68k_callstack_clear(void);
+
+/* Replace the stack with count frames, innermost first as returned by
+ * m68k_get_backtrace_frames (re-seeds a restored snapshot) */
+void m68k_callstack_restore(const m68k_callstack_frame_t* frames, int count);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the CPU core - not part of public API */
+
+/* After the return address / exception frame has been pushed */
+void m68k_callstack_call(uint32_t return_addr, uint32_t target);
+void m68k_callstack_exception(uint32_t return_addr, uint32_t target);
+
+/* After RTS/RTE has pulled its frame */
+void m68k_callstack_return(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KCALLSTACK__HEADER */
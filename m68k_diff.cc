@@ -0,0 +1,198 @@
+/* ======================================================================== */
+/* ========================== M68K SNAPSHOT DIFF ========================= */
+/* ======================================================================== */
+
+#include "m68k_diff.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+/* Each scanner returns the first offset in [pos, size) where a and b
+ * differ, or size */
+using ScanFn = uint32_t (*)(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size);
+
+uint32_t scan_tail(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    while (pos < size && a[pos] == b[pos]) {
+        ++pos;
+    }
+    return pos;
+}
+
+#if !defined(__wasm_simd128__) && !defined(__SSE2__)
+
+uint32_t scan_scalar(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    for (; pos + 8 <= size; pos += 8) {
+        uint64_t x;
+        uint64_t y;
+        std::memcpy(&x, a + pos, sizeof(x));
+        std::memcpy(&y, b + pos, sizeof(y));
+        if (x != y) {
+            return scan_tail(a, b, pos, size);
+        }
+    }
+    return scan_tail(a, b, pos, size);
+}
+
+#endif
+
+#if defined(__wasm_simd128__)
+
+uint32_t scan_simd128(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    for (; pos + 16 <= size; pos += 16) {
+        const v128_t eq = wasm_i8x16_eq(wasm_v128_load(a + pos), wasm_v128_load(b + pos));
+        const uint32_t mask = wasm_i8x16_bitmask(eq);
+        if (mask != 0xFFFFu) {
+            return pos + static_cast<uint32_t>(__builtin_ctz(~mask));
+        }
+    }
+    return scan_tail(a, b, pos, size);
+}
+
+#elif defined(__SSE2__)
+
+uint32_t scan_sse2(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + pos));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + pos));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        if (mask != 0xFFFFu) {
+            return pos + static_cast<uint32_t>(__builtin_ctz(~mask));
+        }
+    }
+    return scan_tail(a, b, pos, size);
+}
+
+#if defined(__GNUC__)
+#define M68K_DIFF_HAVE_AVX2 1
+
+__attribute__((target("avx2")))
+uint32_t scan_avx2(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    for (; pos + 32 <= size; pos += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + pos));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + pos));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (mask != 0xFFFFFFFFu) {
+            return pos + static_cast<uint32_t>(__builtin_ctz(~mask));
+        }
+    }
+    return scan_sse2(a, b, pos, size);
+}
+#endif
+
+#endif
+
+struct Scanner {
+    ScanFn fn;
+    m68k_diff_impl impl;
+};
+
+Scanner pick_scanner()
+{
+#if defined(__wasm_simd128__)
+    return {scan_simd128, M68K_DIFF_SIMD128};
+#elif defined(__SSE2__)
+#if defined(M68K_DIFF_HAVE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return {scan_avx2, M68K_DIFF_AVX2};
+    }
+#endif
+    return {scan_sse2, M68K_DIFF_SSE2};
+#else
+    return {scan_scalar, M68K_DIFF_SCALAR};
+#endif
+}
+
+const Scanner& scanner()
+{
+    static const Scanner picked = pick_scanner();
+    return picked;
+}
+
+/* First offset in [pos, size) where a and b agree, or size */
+uint32_t skip_different(const uint8_t* a, const uint8_t* b, uint32_t pos, uint32_t size)
+{
+    while (pos < size && a[pos] != b[pos]) {
+        ++pos;
+    }
+    return pos;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_diff_memory(const void* a, const void* b, uint32_t size, uint32_t base,
+                     uint32_t merge_gap, m68k_diff_range_t* ranges, int max)
+{
+    if (!a || !b) {
+        return 0;
+    }
+    const uint8_t* x = static_cast<const uint8_t*>(a);
+    const uint8_t* y = static_cast<const uint8_t*>(b);
+    const ScanFn scan = scanner().fn;
+
+    int count = 0;
+    uint32_t pos = scan(x, y, 0, size);
+    while (pos < size) {
+        const uint32_t start = pos;
+        uint32_t end = skip_different(x, y, pos, size);
+        /* Absorb equal gaps no longer than merge_gap */
+        while (end < size) {
+            const uint32_t next = scan(x, y, end, size);
+            if (next == size || next - end > merge_gap) {
+                pos = next;
+                break;
+            }
+            end = skip_different(x, y, next, size);
+        }
+        if (end == size) {
+            pos = size;
+        }
+        if (ranges && count < max) {
+            ranges[count] = m68k_diff_range_t{base + start, end - start};
+        }
+        ++count;
+    }
+    return count;
+}
+
+int m68k_diff_regs(const uint32_t* a, const uint32_t* b, int count, uint32_t* indices)
+{
+    if (!a || !b || !indices) {
+        return 0;
+    }
+    int differing = 0;
+    for (int i = 0; i < count; ++i) {
+        if (a[i] != b[i]) {
+            indices[differing++] = static_cast<uint32_t>(i);
+        }
+    }
+    return differing;
+}
+
+int m68k_diff_impl_in_use(void)
+{
+    return scanner().impl;
+}
+
+} // extern "C"
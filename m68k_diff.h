@@ -0,0 +1,54 @@
+/* ======================================================================== */
+/* ========================== M68K SNAPSHOT DIFF ========================= */
+/* ======================================================================== */
+/* Compares two machine snapshots (memory images plus register arrays) and
+ * reports what differs as compact ranges, for checking a run against a
+ * golden state. Memory is scanned with AVX2 or SSE2 on x86 hosts (picked
+ * at run time), SIMD128 in wasm builds made with ENABLE_WASM_SIMD=1 (which
+ * then need a SIMD-capable engine), and 8-byte words elsewhere. */
+
+#ifndef M68KDIFF__HEADER
+#define M68KDIFF__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef struct m68k_diff_range {
+    uint32_t start;             /* base + offset of the first differing byte */
+    uint32_t length;
+} m68k_diff_range_t;
+
+/* Scanner in use, for diagnostics */
+typedef enum {
+    M68K_DIFF_SCALAR = 0,
+    M68K_DIFF_SSE2,
+    M68K_DIFF_AVX2,
+    M68K_DIFF_SIMD128
+} m68k_diff_impl;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Compares size bytes of a and b. Differing bytes separated by at most
+ * merge_gap equal bytes share one range. Up to max ranges are written,
+ * with start offset by base; returns the total number of ranges, which
+ * exceeds max when the output was truncated. */
+int m68k_diff_memory(const void* a, const void* b, uint32_t size, uint32_t base,
+                     uint32_t merge_gap, m68k_diff_range_t* ranges, int max);
+
+/* Compares count 32-bit registers (e.g. indexed by m68k_register_t) and
+ * writes the indices that differ; returns how many differ. indices must
+ * hold count entries. */
+int m68k_diff_regs(const uint32_t* a, const uint32_t* b, int count, uint32_t* indices);
+
+int m68k_diff_impl_in_use(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KDIFF__HEADER */
@@ -0,0 +1,126 @@
+/* ======================================================================== */
+/* ========================= M68K DIRTY PAGE TRACKING ==================== */
+/* ======================================================================== */
+
+#include "m68k_dirty.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+int m68k_dirty_shift = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+constexpr uint64_t kAddressSpace = 1ull << 24;
+
+/* One bit per page, 64 pages per word */
+std::vector<uint64_t> g_bitmap;
+
+/* Page index range [first, last] overlapping [start, start + size) */
+bool page_span(uint32_t start, uint32_t size, uint32_t* first, uint32_t* last)
+{
+    if (!m68k_dirty_shift || size == 0 || start >= kAddressSpace) {
+        return false;
+    }
+    const uint64_t end = std::min<uint64_t>(static_cast<uint64_t>(start) + size, kAddressSpace);
+    *first = start >> m68k_dirty_shift;
+    *last = static_cast<uint32_t>((end - 1) >> m68k_dirty_shift);
+    return true;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_dirty_enable(int page_shift)
+{
+    if (page_shift != 0 && (page_shift < 8 || page_shift > 24)) {
+        return -1;
+    }
+    m68k_dirty_shift = page_shift;
+    if (page_shift == 0) {
+        g_bitmap.clear();
+        g_bitmap.shrink_to_fit();
+        return 0;
+    }
+    const uint64_t pages = kAddressSpace >> page_shift;
+    g_bitmap.assign(static_cast<size_t>((pages + 63) / 64), 0);
+    return 0;
+}
+
+int m68k_dirty_page_shift(void)
+{
+    return m68k_dirty_shift;
+}
+
+void m68k_dirty_clear(void)
+{
+    std::fill(g_bitmap.begin(), g_bitmap.end(), 0);
+}
+
+int m68k_dirty_get_and_clear(uint32_t start, uint32_t size, uint32_t* pages, int max)
+{
+    uint32_t first;
+    uint32_t last;
+    if (!pages || max <= 0 || !page_span(start, size, &first, &last)) {
+        return 0;
+    }
+    int count = 0;
+    for (uint32_t word = first / 64; word <= last / 64 && count < max; ++word) {
+        uint64_t bits = g_bitmap[word];
+        /* Mask off pages outside [first, last] in the edge words */
+        if (word == first / 64) {
+            bits &= ~0ull << (first % 64);
+        }
+        if (word == last / 64 && last % 64 != 63) {
+            bits &= (1ull << (last % 64 + 1)) - 1;
+        }
+        while (bits && count < max) {
+            const uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(bits));
+            bits &= bits - 1;
+            g_bitmap[word] &= ~(1ull << bit);
+            pages[count++] = (word * 64 + bit) << m68k_dirty_shift;
+        }
+    }
+    return count;
+}
+
+uint32_t m68k_dirty_count(uint32_t start, uint32_t size)
+{
+    uint32_t first;
+    uint32_t last;
+    if (!page_span(start, size, &first, &last)) {
+        return 0;
+    }
+    uint32_t count = 0;
+    for (uint32_t page = first; page <= last; ++page) {
+        count += static_cast<uint32_t>((g_bitmap[page / 64] >> (page % 64)) & 1u);
+    }
+    return count;
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+void m68k_dirty_mark(uint32_t address, uint32_t size)
+{
+    uint32_t first;
+    uint32_t last;
+    if (!page_span(address, size, &first, &last)) {
+        return;
+    }
+    for (uint32_t page = first; page <= last; ++page) {
+        g_bitmap[page / 64] |= 1ull << (page % 64);
+    }
+}
+
+} // extern "C"
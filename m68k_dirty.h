@@ -0,0 +1,60 @@
+/* ======================================================================== */
+/* ========================= M68K DIRTY PAGE TRACKING ==================== */
+/* ======================================================================== */
+/* A bitmap with one bit per page of the 24-bit address space, set by every
+ * guest write and by write_block; writes through a mirror also mark the
+ * page they land in. Consumers that mirror guest memory (tilemaps,
+ * framebuffers, shared state) collect the changed pages after each run
+ * instead of diffing whole buffers.
+ *
+ * With m68k_set_address_width(32) only the low 16 MB is tracked: writes at
+ * or above 0x01000000 mark nothing, and queries there report no pages. */
+
+#ifndef M68KDIRTY__HEADER
+#define M68KDIRTY__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* page_shift 8-24 enables tracking with 2^page_shift byte pages (and clears
+ * the bitmap), 0 disables. Returns -1 for any other shift. */
+int m68k_dirty_enable(int page_shift);
+int m68k_dirty_page_shift(void);
+void m68k_dirty_clear(void);
+
+/* Base addresses of up to max dirty pages overlapping [start, start + size),
+ * lowest first; reported pages are cleared, the rest stay dirty for the
+ * next call. Returns count. */
+int m68k_dirty_get_and_clear(uint32_t start, uint32_t size, uint32_t* pages, int max);
+
+/* Dirty pages overlapping [start, start + size), without clearing */
+uint32_t m68k_dirty_count(uint32_t start, uint32_t size);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the memory bridge and myfunc.cc - not part of public API */
+
+extern int m68k_dirty_shift;
+
+void m68k_dirty_mark(uint32_t address, uint32_t size);
+
+static inline void m68k_dirty_note_write(uint32_t address, uint32_t size)
+{
+    if (m68k_dirty_shift) {
+        m68k_dirty_mark(address, size);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KDIRTY__HEADER */
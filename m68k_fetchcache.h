@@ -0,0 +1,85 @@
+/* ======================================================================== */
+/* ====================== M68K INSTRUCTION FETCH CACHE ==================== */
+/* ======================================================================== */
+/* Internal to the core and memory bridge: remembers the direct page holding
+ * the current PC so opcode and extension-word fetches inside it are a plain
+ * big-endian load instead of a call into the bridge. A fetch outside the
+ * cached page (a jump, or running off its end) refills it; page map
+ * rebuilds, bank remaps, PMMU changes and memo recording invalidate it. */
+
+#ifndef M68KFETCHCACHE__HEADER
+#define M68KFETCHCACHE__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include "m68k_bridgestats.h"
+
+#define M68K_FETCH_PAGE_SIZE 0x1000u     /* Same as the direct page map */
+
+typedef struct m68k_fetch_cache {
+    const uint8_t* base;    /* Host address of the page's first byte, or NULL */
+    uint32_t mask;          /* Address width the page was cached under */
+    uint32_t page;          /* Masked guest address of the page's first byte */
+    uint32_t swapped;       /* Page holds 16-bit words in host order */
+} m68k_fetch_cache_t;
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the core and memory bridge - not part of public API */
+
+extern m68k_fetch_cache_t m68k_fetch_cache;
+
+void m68k_fetch_cache_invalidate(void);
+
+/* Slow path: fetch through m68k_read_immediate_*, then cache the page if
+ * it is direct (implemented in the memory bridge) */
+unsigned int m68k_fetch_cache_miss_16(unsigned int address);
+unsigned int m68k_fetch_cache_miss_32(unsigned int address);
+
+static inline unsigned int m68k_fetch_cache_load_16(const uint8_t* p, uint32_t swapped)
+{
+    if (swapped) {
+        uint16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    return ((unsigned int)p[0] << 8) | p[1];
+}
+
+/* Hits count as region reads and fetches, exactly as the bridge would */
+static inline unsigned int m68k_fetch_16(unsigned int address)
+{
+    const m68k_fetch_cache_t* cache = &m68k_fetch_cache;
+    const uint32_t offset = (address & cache->mask) - cache->page;
+    if (cache->base && offset <= M68K_FETCH_PAGE_SIZE - 2 && !(cache->swapped && (offset & 1))) {
+        m68k_bridge_stats.fetches[1]++;
+        m68k_bridge_stats.reads[M68K_BRIDGE_PATH_REGION][1]++;
+        return m68k_fetch_cache_load_16(cache->base + offset, cache->swapped);
+    }
+    return m68k_fetch_cache_miss_16(address);
+}
+
+static inline unsigned int m68k_fetch_32(unsigned int address)
+{
+    const m68k_fetch_cache_t* cache = &m68k_fetch_cache;
+    const uint32_t offset = (address & cache->mask) - cache->page;
+    if (cache->base && offset <= M68K_FETCH_PAGE_SIZE - 4 && !(cache->swapped && (offset & 1))) {
+        m68k_bridge_stats.fetches[2]++;
+        m68k_bridge_stats.reads[M68K_BRIDGE_PATH_REGION][2]++;
+        return (m68k_fetch_cache_load_16(cache->base + offset, cache->swapped) << 16) |
+               m68k_fetch_cache_load_16(cache->base + offset + 2, cache->swapped);
+    }
+    return m68k_fetch_cache_miss_32(address);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KFETCHCACHE__HEADER */
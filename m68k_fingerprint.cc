@@ -0,0 +1,162 @@
+/* ======================================================================== */
+/* ===================== M68K EXECUTION FINGERPRINTING =================== */
+/* ======================================================================== */
+
+#include "m68k_fingerprint.h"
+#include "m68k.h"
+#include "m68kcpu.h"
+#include <cstdint>
+#include <vector>
+
+int m68k_fingerprint_enabled = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+constexpr uint64_t kSeed = 0x6D36386B66707231ULL;  /* "m68kfpr1" */
+
+struct m68k_fingerprint_state {
+    uint32_t interval = 0;
+    uint32_t until_checkpoint = 0;
+    uint64_t instructions = 0;
+    uint64_t hash = kSeed;
+    uint64_t break_at = 0;
+    std::vector<uint64_t> log;
+};
+
+m68k_fingerprint_state g_fp;
+
+inline uint64_t mix(uint64_t h, uint64_t v) noexcept
+{
+    h ^= v * 0x9E3779B97F4A7C15ULL;
+    h = (h << 27) | (h >> 37);
+    return h * 0xC2B2AE3D27D4EB4FULL;
+}
+
+void append_checkpoint() noexcept
+{
+    uint64_t h = g_fp.hash;
+    for (int i = 0; i < 16; ++i) {
+        h = mix(h, REG_DA[i]);
+    }
+    h = mix(h, m68ki_get_sr());
+    h = mix(h, REG_PC);
+    g_fp.hash = h;
+    g_fp.log.push_back(h);
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_fingerprint_enable(uint32_t interval)
+{
+    if (interval == 0) {
+        return -1;
+    }
+    g_fp.interval = interval;
+    g_fp.until_checkpoint = interval;
+    g_fp.instructions = 0;
+    g_fp.hash = kSeed;
+    g_fp.break_at = 0;
+    g_fp.log.clear();
+    m68k_fingerprint_enabled = 1;
+    return 0;
+}
+
+void m68k_fingerprint_disable(void)
+{
+    m68k_fingerprint_enabled = 0;
+    g_fp.break_at = 0;
+}
+
+int m68k_fingerprint_is_enabled(void)
+{
+    return m68k_fingerprint_enabled;
+}
+
+uint64_t m68k_fingerprint_instructions(void)
+{
+    return g_fp.instructions;
+}
+
+uint64_t m68k_fingerprint_current(void)
+{
+    return g_fp.hash;
+}
+
+uint32_t m68k_fingerprint_count(void)
+{
+    return static_cast<uint32_t>(g_fp.log.size());
+}
+
+const uint64_t* m68k_fingerprint_data(void)
+{
+    return g_fp.log.empty() ? nullptr : g_fp.log.data();
+}
+
+uint32_t m68k_fingerprint_interval(void)
+{
+    return g_fp.interval;
+}
+
+int32_t m68k_fingerprint_find_divergence(const uint64_t* other, uint32_t other_count)
+{
+    uint32_t count = static_cast<uint32_t>(g_fp.log.size());
+    if (other_count < count) {
+        count = other_count;
+    }
+    if (!other || count == 0 || g_fp.log[count - 1] == other[count - 1]) {
+        return -1;
+    }
+
+    /* Invariant: entries before lo match, entry hi differs */
+    uint32_t lo = 0;
+    uint32_t hi = count - 1;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (g_fp.log[mid] == other[mid]) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return static_cast<int32_t>(hi);
+}
+
+void m68k_fingerprint_break_at(uint64_t instruction)
+{
+    g_fp.break_at = instruction;
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+void m68k_fingerprint_record_instruction(uint32_t pc, uint16_t opcode)
+{
+    g_fp.hash = mix(g_fp.hash, (static_cast<uint64_t>(pc) << 16) | opcode);
+    ++g_fp.instructions;
+    if (--g_fp.until_checkpoint == 0) {
+        g_fp.until_checkpoint = g_fp.interval;
+        append_checkpoint();
+    }
+    if (g_fp.break_at != 0 && g_fp.instructions == g_fp.break_at) {
+        m68k_end_timeslice();
+    }
+}
+
+void m68k_fingerprint_record_write(uint32_t address, uint32_t size, uint32_t value)
+{
+    g_fp.hash = mix(g_fp.hash, (static_cast<uint64_t>(address) << 8) | size);
+    g_fp.hash = mix(g_fp.hash, value);
+}
+
+} // extern "C"
@@ -0,0 +1,77 @@
+/* ======================================================================== */
+/* ===================== M68K EXECUTION FINGERPRINTING =================== */
+/* ======================================================================== */
+
+#ifndef M68KFINGERPRINT__HEADER
+#define M68KFINGERPRINT__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* A rolling 64-bit hash over every executed instruction (PC, opcode) and
+ * every memory write (address, size, value). Every `interval` instructions
+ * the register file (D0-D7, A0-A7, SR, PC) is folded in and the hash is
+ * appended to the fingerprint log. Because the hash is cumulative, two runs
+ * agree on a prefix of the log and differ from the first divergent window
+ * onwards, so the first differing checkpoint is found by binary search. */
+
+/* Start fingerprinting from instruction 0 with a checkpoint every interval
+ * instructions (clears the log). Returns 0, or -1 if interval is 0. */
+int m68k_fingerprint_enable(uint32_t interval);
+void m68k_fingerprint_disable(void);
+int m68k_fingerprint_is_enabled(void);
+
+/* Instructions fingerprinted and the rolling hash so far */
+uint64_t m68k_fingerprint_instructions(void);
+uint64_t m68k_fingerprint_current(void);
+
+/* Fingerprint log: checkpoint k covers instructions [0, (k+1)*interval) */
+uint32_t m68k_fingerprint_count(void);
+const uint64_t* m68k_fingerprint_data(void);
+uint32_t m68k_fingerprint_interval(void);
+
+/* Index of the first checkpoint where this run's log differs from another
+ * log, or -1 if they agree over their common length. The differing window
+ * is instructions [index*interval, (index+1)*interval). */
+int32_t m68k_fingerprint_find_divergence(const uint64_t* other, uint32_t other_count);
+
+/* End the timeslice once `instruction` instructions have executed, so a
+ * re-run can stop at a window start before tracing it (0 disables). */
+void m68k_fingerprint_break_at(uint64_t instruction);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the CPU core - not part of public API */
+
+extern int m68k_fingerprint_enabled;
+
+void m68k_fingerprint_record_instruction(uint32_t pc, uint16_t opcode);
+void m68k_fingerprint_record_write(uint32_t address, uint32_t size, uint32_t value);
+
+static inline void m68k_fingerprint_instruction(uint32_t pc, uint16_t opcode)
+{
+    if (m68k_fingerprint_enabled) {
+        m68k_fingerprint_record_instruction(pc, opcode);
+    }
+}
+
+static inline void m68k_fingerprint_write(uint32_t address, uint32_t size, uint32_t value)
+{
+    if (m68k_fingerprint_enabled) {
+        m68k_fingerprint_record_write(address, size, value);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KFINGERPRINT__HEADER */
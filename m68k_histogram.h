@@ -0,0 +1,107 @@
+/* ======================================================================== */
+/* ======================== M68K LATENCY HISTOGRAMS ====================== */
+/* ======================================================================== */
+
+#ifndef M68KHISTOGRAM__HEADER
+#define M68KHISTOGRAM__HEADER
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Summary of one latency distribution (all fields uint32 for HEAPU32).
+ * p99 is the upper edge of the histogram bucket holding the 99th
+ * percentile, so it overestimates by at most 25%. */
+typedef struct m68k_latency_stats {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t avg;
+    uint32_t p99;
+} m68k_latency_stats_t;
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+/* ======================================================================== */
+/* ======================= INTERNAL C++ INTERFACE ======================= */
+/* ======================================================================== */
+
+#include <cstdint>
+
+namespace m68k_histogram {
+
+/* Log-linear histogram: exact below 8, then four buckets per power of two */
+class LatencyHistogram {
+public:
+    static constexpr int kBuckets = 8 + 29 * 4;
+
+    void record(uint32_t value) noexcept {
+        buckets_[bucket_of(value)]++;
+        if (count_ == 0 || value < min_) min_ = value;
+        if (value > max_) max_ = value;
+        sum_ += value;
+        count_++;
+    }
+
+    void reset() noexcept { *this = LatencyHistogram(); }
+
+    void summarize(m68k_latency_stats_t& out) const noexcept {
+        out.count = static_cast<uint32_t>(count_);
+        out.min = min_;
+        out.max = max_;
+        out.avg = count_ ? static_cast<uint32_t>(sum_ / count_) : 0;
+        out.p99 = percentile(99);
+    }
+
+    uint64_t count() const noexcept { return count_; }
+
+private:
+    static int bucket_of(uint32_t v) noexcept {
+        if (v < 8) {
+            return static_cast<int>(v);
+        }
+        int e = 31;
+        while (!(v & (1u << e))) --e;
+        return 8 + (e - 3) * 4 + static_cast<int>((v >> (e - 2)) & 3);
+    }
+
+    static uint32_t bucket_high(int idx) noexcept {
+        if (idx < 8) {
+            return static_cast<uint32_t>(idx);
+        }
+        const int e = (idx - 8) / 4 + 3;
+        const uint64_t low = static_cast<uint64_t>(4 + (idx - 8) % 4) << (e - 2);
+        return static_cast<uint32_t>(low + (1ULL << (e - 2)) - 1);
+    }
+
+    uint32_t percentile(int pct) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+        const uint64_t rank = (count_ * static_cast<uint64_t>(pct) + 99) / 100;
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                const uint32_t high = bucket_high(i);
+                return high < max_ ? high : max_;
+            }
+        }
+        return max_;
+    }
+
+    uint32_t buckets_[kBuckets] = {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint32_t min_ = 0;
+    uint32_t max_ = 0;
+};
+
+}  // namespace m68k_histogram
+
+#endif /* __cplusplus */
+
+#endif /* M68KHISTOGRAM__HEADER */
@@ -0,0 +1,137 @@
+/* ======================================================================== */
+/* ===================== M68K HOST CALLBACK COST STATS =================== */
+/* ======================================================================== */
+
+#include "m68k_hookcost.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+int m68k_hookcost_active = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+using m68k_histogram::LatencyHistogram;
+
+struct Cost {
+    LatencyHistogram histogram;
+    uint64_t total_ns = 0;
+
+    void record(uint64_t ns) noexcept {
+        histogram.record(ns > 0xFFFFFFFFULL ? 0xFFFFFFFFu : static_cast<uint32_t>(ns));
+        total_ns += ns;
+    }
+
+    void summarize(m68k_hook_cost_t& out) const noexcept {
+        out.total_ns_lo = static_cast<uint32_t>(total_ns);
+        out.total_ns_hi = static_cast<uint32_t>(total_ns >> 32);
+        histogram.summarize(out.latency);
+    }
+};
+
+struct m68k_hookcost_state {
+    Cost kinds[M68K_HOOK_KIND_COUNT];
+    std::unordered_map<uint32_t, Cost> pcs;
+    m68k_hookcost_stats_t snapshot{};
+    m68k_hook_cost_t pc_snapshot{};
+};
+
+m68k_hookcost_state g_cost;
+
+inline bool is_per_pc(m68k_hook_kind kind) noexcept
+{
+    return kind == M68K_HOOK_KIND_PROBE || kind == M68K_HOOK_KIND_PC_HOOK;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+void m68k_hookcost_enable(int enable)
+{
+    m68k_hookcost_active = enable ? 1 : 0;
+}
+
+void m68k_hookcost_reset(void)
+{
+    for (Cost& cost : g_cost.kinds) {
+        cost = Cost{};
+    }
+    g_cost.pcs.clear();
+}
+
+m68k_hookcost_stats_t* m68k_hookcost_stats_ptr(void)
+{
+    m68k_hookcost_stats_t& out = g_cost.snapshot;
+    out.enabled = static_cast<uint32_t>(m68k_hookcost_active);
+    out.probe_pcs = static_cast<uint32_t>(g_cost.pcs.size());
+    for (int i = 0; i < M68K_HOOK_KIND_COUNT; ++i) {
+        g_cost.kinds[i].summarize(out.kinds[i]);
+    }
+    return &out;
+}
+
+m68k_hook_cost_t* m68k_hookcost_pc_ptr(uint32_t pc)
+{
+    auto it = g_cost.pcs.find(pc);
+    if (it == g_cost.pcs.end()) {
+        return nullptr;
+    }
+    it->second.summarize(g_cost.pc_snapshot);
+    return &g_cost.pc_snapshot;
+}
+
+int m68k_hookcost_top_pcs(uint32_t* pcs, int max)
+{
+    if (!pcs || max <= 0) {
+        return 0;
+    }
+    std::vector<std::pair<uint64_t, uint32_t>> ranked;
+    ranked.reserve(g_cost.pcs.size());
+    for (const auto& kv : g_cost.pcs) {
+        ranked.emplace_back(kv.second.total_ns, kv.first);
+    }
+    const size_t count = std::min(ranked.size(), static_cast<size_t>(max));
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(count), ranked.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+    for (size_t i = 0; i < count; ++i) {
+        pcs[i] = ranked[i].second;
+    }
+    return static_cast<int>(count);
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+uint64_t m68k_hookcost_now_ns(void)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void m68k_hookcost_record(m68k_hook_kind kind, uint32_t pc, uint64_t elapsed_ns)
+{
+    if (kind < 0 || kind >= M68K_HOOK_KIND_COUNT) {
+        return;
+    }
+    g_cost.kinds[kind].record(elapsed_ns);
+    if (is_per_pc(kind)) {
+        g_cost.pcs[pc].record(elapsed_ns);
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,106 @@
+/* ======================================================================== */
+/* ===================== M68K HOST CALLBACK COST STATS =================== */
+/* ======================================================================== */
+
+#ifndef M68KHOOKCOST__HEADER
+#define M68KHOOKCOST__HEADER
+
+#include <stdint.h>
+#include "m68k_histogram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Host crossings that are timed */
+typedef enum {
+    M68K_HOOK_KIND_PROBE = 0,       /* js_probe_callback */
+    M68K_HOOK_KIND_PC_HOOK,         /* _pc_hook (set_pc_hook_func) */
+    M68K_HOOK_KIND_INSTR_HOOK,      /* _instr_hook (set_full_instr_hook_func) */
+    M68K_HOOK_KIND_JS_READ,         /* js_read8 / js_read16 / js_read32 callbacks */
+    M68K_HOOK_KIND_JS_WRITE,        /* js_write8 / js_write16 / js_write32 callbacks */
+    M68K_HOOK_KIND_READ_MEM,        /* _read_mem (set_read_mem_func) */
+    M68K_HOOK_KIND_WRITE_MEM,       /* _write_mem (set_write_mem_func) */
+    M68K_HOOK_KIND_TRACE_INSTR,     /* m68k_set_trace_instr_callback */
+    M68K_HOOK_KIND_TRACE_FLOW,      /* m68k_set_trace_flow_callback */
+    M68K_HOOK_KIND_TRACE_MEM,       /* m68k_set_trace_mem_callback */
+    M68K_HOOK_KIND_COUNT
+} m68k_hook_kind;
+
+/* Cost of one callback kind or probe PC; latencies in nanoseconds */
+typedef struct m68k_hook_cost {
+    uint32_t total_ns_lo;           /* Total time spent in the host */
+    uint32_t total_ns_hi;
+    m68k_latency_stats_t latency;
+} m68k_hook_cost_t;
+
+typedef struct m68k_hookcost_stats {
+    uint32_t enabled;
+    uint32_t probe_pcs;             /* Distinct PCs with probe / PC hook samples */
+    m68k_hook_cost_t kinds[M68K_HOOK_KIND_COUNT];
+} m68k_hookcost_stats_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Off by default; when off each crossing costs one branch. A memory access
+ * through js_read8/js_write8 is timed as one sample even when a 16/32-bit
+ * access makes several byte calls. Probe and PC hook samples are also kept
+ * per guest PC. */
+void m68k_hookcost_enable(int enable);
+void m68k_hookcost_reset(void);
+
+/* Refreshed on every call */
+m68k_hookcost_stats_t* m68k_hookcost_stats_ptr(void);
+
+/* Per-PC cost of probe and PC hook callbacks, or NULL if none recorded;
+ * refreshed on every call */
+m68k_hook_cost_t* m68k_hookcost_pc_ptr(uint32_t pc);
+
+/* Up to max probe PCs, most expensive (total time) first. Returns count. */
+int m68k_hookcost_top_pcs(uint32_t* pcs, int max);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from myfunc.cc and m68ktrace.cc - not part of public API */
+
+extern int m68k_hookcost_active;
+
+uint64_t m68k_hookcost_now_ns(void);
+void m68k_hookcost_record(m68k_hook_kind kind, uint32_t pc, uint64_t elapsed_ns);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+namespace m68k_hookcost {
+
+/* Times the enclosing scope when accounting is enabled */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(m68k_hook_kind kind, uint32_t pc = 0) noexcept
+        : kind_(kind), pc_(pc), active_(m68k_hookcost_active != 0),
+          start_(active_ ? m68k_hookcost_now_ns() : 0) {}
+
+    ~ScopedTimer() {
+        if (active_) {
+            m68k_hookcost_record(kind_, pc_, m68k_hookcost_now_ns() - start_);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    m68k_hook_kind kind_;
+    uint32_t pc_;
+    bool active_;
+    uint64_t start_;
+};
+
+}  // namespace m68k_hookcost
+
+#endif /* __cplusplus */
+
+#endif /* M68KHOOKCOST__HEADER */
@@ -7060,13 +7060,19 @@ M68KMAKE_OP(movem, 16, re, pd)
 	uint ea = AY;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			ea -= 2;
-			m68ki_write_16(ea, MASK_OUT_ABOVE_16(REG_DA[15-i]));
-			count++;
-		}
+	if(m68ki_movem_store(ea - (m68ki_movem_count(register_list) << 1), m68ki_movem_pd_mask(register_list), 2, 0))
+	{
+		count = m68ki_movem_count(register_list);
+		ea -= count << 1;
+	}
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				ea -= 2;
+				m68ki_write_16(ea, MASK_OUT_ABOVE_16(REG_DA[15-i]));
+				count++;
+			}
 	AY = ea;
 
 	USE_CYCLES(count<<CYC_MOVEM_W);
@@ -7080,13 +7086,16 @@ M68KMAKE_OP(movem, 16, re, .)
 	uint ea = M68KMAKE_GET_EA_AY_16;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			m68ki_write_16(ea, MASK_OUT_ABOVE_16(REG_DA[i]));
-			ea += 2;
-			count++;
-		}
+	if(m68ki_movem_store(ea, register_list, 2, 0))
+		count = m68ki_movem_count(register_list);
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				m68ki_write_16(ea, MASK_OUT_ABOVE_16(REG_DA[i]));
+				ea += 2;
+				count++;
+			}
 
 	USE_CYCLES(count<<CYC_MOVEM_W);
 }
@@ -7099,14 +7108,20 @@ M68KMAKE_OP(movem, 32, re, pd)
 	uint ea = AY;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			ea -= 4;
-			m68ki_write_16(ea+2, REG_DA[15-i] & 0xFFFF );
-			m68ki_write_16(ea, (REG_DA[15-i] >> 16) & 0xFFFF );
-			count++;
-		}
+	if(m68ki_movem_store(ea - (m68ki_movem_count(register_list) << 2), m68ki_movem_pd_mask(register_list), 4, 1))
+	{
+		count = m68ki_movem_count(register_list);
+		ea -= count << 2;
+	}
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				ea -= 4;
+				m68ki_write_16(ea+2, REG_DA[15-i] & 0xFFFF );
+				m68ki_write_16(ea, (REG_DA[15-i] >> 16) & 0xFFFF );
+				count++;
+			}
 	AY = ea;
 
 	USE_CYCLES(count<<CYC_MOVEM_L);
@@ -7120,13 +7135,16 @@ M68KMAKE_OP(movem, 32, re, .)
 	uint ea = M68KMAKE_GET_EA_AY_32;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			m68ki_write_32(ea, REG_DA[i]);
-			ea += 4;
-			count++;
-		}
+	if(m68ki_movem_store(ea, register_list, 4, 0))
+		count = m68ki_movem_count(register_list);
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				m68ki_write_32(ea, REG_DA[i]);
+				ea += 4;
+				count++;
+			}
 
 	USE_CYCLES(count<<CYC_MOVEM_L);
 }
@@ -7139,13 +7157,19 @@ M68KMAKE_OP(movem, 16, er, pi)
 	uint ea = AY;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			REG_DA[i] = MAKE_INT_16(MASK_OUT_ABOVE_16(m68ki_read_16(ea)));
-			ea += 2;
-			count++;
-		}
+	if(m68ki_movem_load(ea, register_list, 2))
+	{
+		count = m68ki_movem_count(register_list);
+		ea += count << 1;
+	}
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				REG_DA[i] = MAKE_INT_16(MASK_OUT_ABOVE_16(m68ki_read_16(ea)));
+				ea += 2;
+				count++;
+			}
 	AY = ea;
 
 	USE_CYCLES(count<<CYC_MOVEM_W);
@@ -7197,13 +7221,16 @@ M68KMAKE_OP(movem, 16, er, .)
 	uint ea = M68KMAKE_GET_EA_AY_16;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			REG_DA[i] = MAKE_INT_16(MASK_OUT_ABOVE_16(m68ki_read_16(ea)));
-			ea += 2;
-			count++;
-		}
+	if(m68ki_movem_load(ea, register_list, 2))
+		count = m68ki_movem_count(register_list);
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				REG_DA[i] = MAKE_INT_16(MASK_OUT_ABOVE_16(m68ki_read_16(ea)));
+				ea += 2;
+				count++;
+			}
 
 	USE_CYCLES(count<<CYC_MOVEM_W);
 }
@@ -7216,13 +7243,19 @@ M68KMAKE_OP(movem, 32, er, pi)
 	uint ea = AY;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			REG_DA[i] = m68ki_read_32(ea);
-			ea += 4;
-			count++;
-		}
+	if(m68ki_movem_load(ea, register_list, 4))
+	{
+		count = m68ki_movem_count(register_list);
+		ea += count << 2;
+	}
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				REG_DA[i] = m68ki_read_32(ea);
+				ea += 4;
+				count++;
+			}
 	AY = ea;
 
 	USE_CYCLES(count<<CYC_MOVEM_L);
@@ -7274,13 +7307,16 @@ M68KMAKE_OP(movem, 32, er, .)
 	uint ea = M68KMAKE_GET_EA_AY_32;
 	uint count = 0;
 
-	for(; i < 16; i++)
-		if(register_list & (1 << i))
-		{
-			REG_DA[i] = m68ki_read_32(ea);
-			ea += 4;
-			count++;
-		}
+	if(m68ki_movem_load(ea, register_list, 4))
+		count = m68ki_movem_count(register_list);
+	else
+		for(; i < 16; i++)
+			if(register_list & (1 << i))
+			{
+				REG_DA[i] = m68ki_read_32(ea);
+				ea += 4;
+				count++;
+			}
 
 	USE_CYCLES(count<<CYC_MOVEM_L);
 }
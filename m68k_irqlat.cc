@@ -0,0 +1,197 @@
+/* ======================================================================== */
+/* ===================== M68K INTERRUPT LATENCY STATS ==================== */
+/* ======================================================================== */
+
+#include "m68k_irqlat.h"
+#include "m68k_perfetto.h"
+#include "m68kcpu.h"
+#include <cstdint>
+
+int m68k_irqlat_entry_pending = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+using m68k_histogram::LatencyHistogram;
+
+constexpr int kLevels = 8;
+constexpr int kMaxInService = 8;
+
+struct LevelHistograms {
+    LatencyHistogram ack;
+    LatencyHistogram entry;
+    LatencyHistogram handler;
+};
+
+/* An interrupt whose handler has not returned yet */
+struct InService {
+    unsigned int level;
+    unsigned int vector;
+    uint32_t handler_pc;
+    uint32_t frame_sp;
+    uint32_t stack;
+    bool asserted;
+    bool entered;               /* Handler's first instruction has started */
+    uint64_t assert_cycle;
+    uint64_t entry_cycle;
+};
+
+struct m68k_irqlat_state {
+    LevelHistograms levels[kLevels];
+    bool pending[kLevels] = {};
+    uint64_t assert_cycle[kLevels] = {};
+    InService in_service[kMaxInService];
+    int depth = 0;
+    m68k_irq_level_stats_t snapshot{};
+};
+
+m68k_irqlat_state g_irq;
+
+inline uint32_t active_stack() noexcept
+{
+    return FLAG_S | ((FLAG_S >> 1) & FLAG_M);
+}
+
+inline uint32_t stack_pointer(uint32_t stack) noexcept
+{
+    return stack == active_stack() ? REG_SP : REG_SP_BASE[stack];
+}
+
+inline uint32_t cycles_between(uint64_t from, uint64_t to) noexcept
+{
+    const uint64_t delta = to > from ? to - from : 0;
+    return delta > 0xFFFFFFFFULL ? 0xFFFFFFFFu : static_cast<uint32_t>(delta);
+}
+
+void refresh_entry_pending() noexcept
+{
+    m68k_irqlat_entry_pending = 0;
+    for (int i = 0; i < g_irq.depth; ++i) {
+        if (!g_irq.in_service[i].entered) {
+            m68k_irqlat_entry_pending = 1;
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+m68k_irq_level_stats_t* m68k_irqlat_stats_ptr(int level)
+{
+    if (level < 1 || level >= kLevels) {
+        return nullptr;
+    }
+    const LevelHistograms& h = g_irq.levels[level];
+    h.ack.summarize(g_irq.snapshot.ack);
+    h.entry.summarize(g_irq.snapshot.entry);
+    h.handler.summarize(g_irq.snapshot.handler);
+    return &g_irq.snapshot;
+}
+
+void m68k_irqlat_reset(void)
+{
+    for (int i = 0; i < kLevels; ++i) {
+        g_irq.levels[i].ack.reset();
+        g_irq.levels[i].entry.reset();
+        g_irq.levels[i].handler.reset();
+        g_irq.pending[i] = false;
+    }
+    g_irq.depth = 0;
+    refresh_entry_pending();
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+void m68k_irqlat_note_level(unsigned int old_level, unsigned int new_level)
+{
+    if (new_level == old_level || new_level >= kLevels) {
+        return;
+    }
+    if (old_level < kLevels) {
+        g_irq.pending[old_level] = false;
+    }
+    if (new_level != 0) {
+        g_irq.pending[new_level] = true;
+        g_irq.assert_cycle[new_level] = m68k_history_clock();
+    }
+}
+
+void m68k_irqlat_note_ack(unsigned int level, unsigned int vector, unsigned int handler_pc)
+{
+    if (level >= kLevels) {
+        return;
+    }
+    const uint64_t now = m68k_history_clock();
+
+    InService irq{};
+    irq.level = level;
+    irq.vector = vector;
+    irq.handler_pc = handler_pc;
+    irq.frame_sp = REG_SP;
+    irq.stack = active_stack();
+    irq.asserted = g_irq.pending[level];
+    irq.assert_cycle = irq.asserted ? g_irq.assert_cycle[level] : now;
+    irq.entry_cycle = now;
+    g_irq.pending[level] = false;
+
+    if (irq.asserted) {
+        g_irq.levels[level].ack.record(cycles_between(irq.assert_cycle, now));
+    }
+    if (g_irq.depth == kMaxInService) {
+        /* Runaway nesting: forget the oldest */
+        for (int i = 1; i < kMaxInService; ++i) {
+            g_irq.in_service[i - 1] = g_irq.in_service[i];
+        }
+        --g_irq.depth;
+    }
+    g_irq.in_service[g_irq.depth++] = irq;
+    m68k_irqlat_entry_pending = 1;
+}
+
+void m68k_irqlat_record_entry(unsigned int pc)
+{
+    if (g_irq.depth == 0) {
+        m68k_irqlat_entry_pending = 0;
+        return;
+    }
+    InService& top = g_irq.in_service[g_irq.depth - 1];
+    if (top.entered || pc != top.handler_pc) {
+        return;
+    }
+    top.entered = true;
+    top.entry_cycle = m68k_history_clock();
+    if (top.asserted) {
+        g_irq.levels[top.level].entry.record(cycles_between(top.assert_cycle, top.entry_cycle));
+    }
+    refresh_entry_pending();
+}
+
+void m68k_irqlat_note_rte(void)
+{
+    const uint64_t now = m68k_history_clock();
+    /* Every interrupt frame the stack has been unwound past has returned */
+    while (g_irq.depth > 0) {
+        const InService& top = g_irq.in_service[g_irq.depth - 1];
+        if (stack_pointer(top.stack) <= top.frame_sp) {
+            break;
+        }
+        g_irq.levels[top.level].handler.record(cycles_between(top.entry_cycle, now));
+        m68k_perfetto_interrupt_event(top.level, top.vector, top.assert_cycle,
+                                      top.entry_cycle, now);
+        --g_irq.depth;
+    }
+    refresh_entry_pending();
+}
+
+} // extern "C"
@@ -0,0 +1,66 @@
+/* ======================================================================== */
+/* ===================== M68K INTERRUPT LATENCY STATS ==================== */
+/* ======================================================================== */
+
+#ifndef M68KIRQLAT__HEADER
+#define M68KIRQLAT__HEADER
+
+#include <stdint.h>
+#include "m68k_histogram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-level latency summaries, in CPU cycles */
+typedef struct m68k_irq_level_stats {
+    m68k_latency_stats_t ack;      /* IRQ asserted -> acknowledge / vector fetch */
+    m68k_latency_stats_t entry;    /* IRQ asserted -> first handler instruction */
+    m68k_latency_stats_t handler;  /* First handler instruction -> matching RTE */
+} m68k_irq_level_stats_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Always on. An assertion is a change of the level passed to m68k_set_irq
+ * (directly or via m68k_set_virq) to a new non-zero level; a level that
+ * stays asserted after its handler returns does not start a new assertion,
+ * so back-to-back services of a held line only contribute handler times.
+ * Timestamps use the history cycle clock (see m68k_history_clock). */
+
+/* Summaries for level 1-7 (NULL otherwise); refreshed on every call */
+m68k_irq_level_stats_t* m68k_irqlat_stats_ptr(int level);
+void m68k_irqlat_reset(void);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the CPU core - not part of public API */
+
+void m68k_irqlat_note_level(unsigned int old_level, unsigned int new_level);
+
+/* After the interrupt frame is stacked, before jumping to handler_pc */
+void m68k_irqlat_note_ack(unsigned int level, unsigned int vector, unsigned int handler_pc);
+
+/* Before each instruction: entry is stamped when the innermost acknowledged
+ * handler starts at its first instruction, so a higher level taken first
+ * counts towards the lower level's entry time */
+extern int m68k_irqlat_entry_pending;
+void m68k_irqlat_record_entry(unsigned int pc);
+
+static inline void m68k_irqlat_note_instruction(unsigned int pc)
+{
+    if (m68k_irqlat_entry_pending) {
+        m68k_irqlat_record_entry(pc);
+    }
+}
+
+/* After RTE has pulled its frame */
+void m68k_irqlat_note_rte(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KIRQLAT__HEADER */
@@ -0,0 +1,389 @@
+/* ======================================================================== */
+/* ===================== M68K GUEST CALL MEMOIZATION ===================== */
+/* ======================================================================== */
+
+#include "m68k_memo.h"
+#include "m68k_fetchcache.h"
+#include "m68k_pagemap.h"
+#include "m68k_replay.h"
+#include "m68k.h"
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+int m68k_memo_active = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+constexpr size_t kMaxEntriesPerPc = 16;
+constexpr size_t kMaxTouchedBytes = 64 * 1024;
+
+/* Registers compared on entry and restored on a hit (SR first: it selects A7) */
+constexpr m68k_register_t kStateRegs[] = {
+    M68K_REG_SR,
+    M68K_REG_D0, M68K_REG_D1, M68K_REG_D2, M68K_REG_D3,
+    M68K_REG_D4, M68K_REG_D5, M68K_REG_D6, M68K_REG_D7,
+    M68K_REG_A0, M68K_REG_A1, M68K_REG_A2, M68K_REG_A3,
+    M68K_REG_A4, M68K_REG_A5, M68K_REG_A6, M68K_REG_A7,
+};
+constexpr size_t kStateRegCount = sizeof(kStateRegs) / sizeof(kStateRegs[0]);
+
+struct RegisterFile {
+    uint32_t regs[kStateRegCount];
+
+    void capture() {
+        for (size_t i = 0; i < kStateRegCount; ++i) {
+            regs[i] = m68k_get_reg(nullptr, kStateRegs[i]);
+        }
+    }
+    bool operator==(const RegisterFile& other) const {
+        for (size_t i = 0; i < kStateRegCount; ++i) {
+            if (regs[i] != other.regs[i]) return false;
+        }
+        return true;
+    }
+};
+
+using ByteList = std::vector<std::pair<uint32_t, uint8_t>>;
+
+struct MemoEntry {
+    RegisterFile inputs;
+    ByteList reads;          /* Bytes read before the call wrote them */
+    ByteList writes;         /* Final value of every byte written */
+    RegisterFile outputs;
+    uint32_t out_pc;
+    uint32_t out_ppc;
+    unsigned long long cycles;
+};
+
+struct MemoSlot {
+    bool enabled = false;
+    std::vector<MemoEntry> entries;
+    size_t next_victim = 0;
+    m68k_memo_stats_t stats{};
+};
+
+struct Recording {
+    int depth = 0;
+    bool overflow = false;       /* Not cacheable: too large, re-entered or host reads */
+    bool returned = false;       /* Sentinel reached; later traffic is not the call's */
+    uint32_t entry_pc = 0;
+    uint32_t return_pc = 0;
+    MemoEntry entry{};
+    std::unordered_set<uint32_t> read_seen;
+    std::unordered_map<uint32_t, size_t> write_index;
+};
+
+struct m68k_memo_state {
+    std::unordered_map<uint32_t, MemoSlot> slots;
+    Recording rec;
+    m68k_memo_stats_t snapshot{};
+};
+
+m68k_memo_state g_memo;
+
+MemoSlot* find_enabled_slot(uint32_t entry_pc)
+{
+    auto it = g_memo.slots.find(entry_pc);
+    return (it != g_memo.slots.end() && it->second.enabled) ? &it->second : nullptr;
+}
+
+/* Read-sets only hold direct-page bytes, so they are checked in place
+ * without running MMIO handlers or host callbacks */
+bool read_set_matches(const MemoEntry& entry)
+{
+    for (const auto& byte : entry.reads) {
+        uint8_t value;
+        if (!m68k_pagemap::peek(byte.first, &value) || value != byte.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Writes go through the bridge like the guest's own, so dirty pages,
+ * fingerprints and watchpoints see a hit the same as an executed call */
+void apply_entry(const MemoEntry& entry)
+{
+    for (const auto& byte : entry.writes) {
+        m68k_write_memory_8(byte.first, byte.second);
+    }
+    for (size_t i = 0; i < kStateRegCount; ++i) {
+        m68k_set_reg(kStateRegs[i], entry.outputs.regs[i]);
+    }
+    m68k_set_reg(M68K_REG_PPC, entry.out_ppc);
+    m68k_set_reg(M68K_REG_PC, entry.out_pc);
+}
+
+void store_entry(MemoSlot& slot, MemoEntry&& entry)
+{
+    if (slot.entries.size() < kMaxEntriesPerPc) {
+        slot.entries.push_back(std::move(entry));
+    } else {
+        /* Round-robin replacement keeps the lookup list bounded */
+        slot.entries[slot.next_victim] = std::move(entry);
+        slot.next_victim = (slot.next_victim + 1) % kMaxEntriesPerPc;
+        slot.stats.evicted++;
+    }
+    slot.stats.recorded++;
+}
+
+void reset_recording()
+{
+    m68k_memo_active = 0;
+    g_memo.rec.overflow = false;
+    g_memo.rec.returned = false;
+    g_memo.rec.entry = MemoEntry{};
+    g_memo.rec.read_seen.clear();
+    g_memo.rec.write_index.clear();
+}
+
+/* The opcode fetch at the sentinel is the call's exit, not an input;
+ * compared on 24 bits like the sentinel itself */
+inline bool is_return_fetch(uint32_t address)
+{
+    return ((address - g_memo.rec.return_pc) & 0x00FFFFFFu) < 4;
+}
+
+inline bool touched_too_much()
+{
+    return g_memo.rec.read_seen.size() + g_memo.rec.write_index.size() > kMaxTouchedBytes;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+void m68k_memo_enable(unsigned int entry_pc)
+{
+    g_memo.slots[entry_pc].enabled = true;
+}
+
+void m68k_memo_disable(unsigned int entry_pc)
+{
+    auto it = g_memo.slots.find(entry_pc);
+    if (it == g_memo.slots.end()) {
+        return;
+    }
+    it->second.enabled = false;
+    it->second.entries.clear();
+    it->second.next_victim = 0;
+}
+
+void m68k_memo_disable_all(void)
+{
+    g_memo.slots.clear();
+    g_memo.rec.depth = 0;
+    reset_recording();
+}
+
+void m68k_memo_invalidate(unsigned int entry_pc)
+{
+    auto it = g_memo.slots.find(entry_pc);
+    if (it == g_memo.slots.end()) {
+        return;
+    }
+    it->second.stats.invalidated += static_cast<uint32_t>(it->second.entries.size());
+    it->second.entries.clear();
+    it->second.next_victim = 0;
+}
+
+void m68k_memo_invalidate_all(void)
+{
+    for (auto& kv : g_memo.slots) {
+        m68k_memo_invalidate(kv.first);
+    }
+}
+
+void m68k_memo_invalidate_range(unsigned int start, unsigned int size)
+{
+    const uint64_t begin = start;
+    const uint64_t end = begin + size;
+    for (auto& kv : g_memo.slots) {
+        MemoSlot& slot = kv.second;
+        for (size_t i = 0; i < slot.entries.size();) {
+            bool overlaps = false;
+            for (const auto& byte : slot.entries[i].reads) {
+                if (byte.first >= begin && byte.first < end) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (overlaps) {
+                slot.entries.erase(slot.entries.begin() + static_cast<std::ptrdiff_t>(i));
+                slot.stats.invalidated++;
+            } else {
+                ++i;
+            }
+        }
+        slot.next_victim = 0;
+    }
+}
+
+m68k_memo_stats_t* m68k_memo_stats_ptr(unsigned int entry_pc)
+{
+    m68k_memo_stats_t& out = g_memo.snapshot;
+    out = m68k_memo_stats_t{};
+    for (const auto& kv : g_memo.slots) {
+        if (entry_pc != M68K_MEMO_ALL && kv.first != entry_pc) {
+            continue;
+        }
+        const m68k_memo_stats_t& s = kv.second.stats;
+        out.hits += s.hits;
+        out.misses += s.misses;
+        out.recorded += s.recorded;
+        out.rejected += s.rejected;
+        out.invalidated += s.invalidated;
+        out.evicted += s.evicted;
+        out.entries += static_cast<uint32_t>(kv.second.entries.size());
+    }
+    return &out;
+}
+
+void m68k_memo_reset_stats(void)
+{
+    for (auto& kv : g_memo.slots) {
+        kv.second.stats = m68k_memo_stats_t{};
+    }
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+int m68k_memo_lookup(unsigned int entry_pc, unsigned long long* cycles)
+{
+    /* Replay and time travel need the call to really execute */
+    if (g_memo.rec.depth > 0 || m68k_replay_get_mode() != M68K_REPLAY_OFF) {
+        return 0;
+    }
+    MemoSlot* slot = find_enabled_slot(entry_pc);
+    if (!slot) {
+        return 0;
+    }
+
+    RegisterFile inputs;
+    inputs.capture();
+    for (const MemoEntry& entry : slot->entries) {
+        if (entry.inputs == inputs && read_set_matches(entry)) {
+            apply_entry(entry);
+            if (cycles) *cycles = entry.cycles;
+            slot->stats.hits++;
+            return 1;
+        }
+    }
+    slot->stats.misses++;
+    return 0;
+}
+
+void m68k_memo_begin(unsigned int entry_pc, unsigned int return_pc)
+{
+    Recording& rec = g_memo.rec;
+    if (rec.depth++ > 0) {
+        /* A host hook re-entered the call API: the outer call is not pure */
+        rec.overflow = true;
+        return;
+    }
+    if (m68k_replay_get_mode() != M68K_REPLAY_OFF || !find_enabled_slot(entry_pc)) {
+        return;
+    }
+    reset_recording();
+    m68k_memo_active = 1;
+    m68k_fetch_cache_invalidate();
+    rec.entry_pc = entry_pc;
+    rec.return_pc = return_pc;
+    rec.entry.inputs.capture();
+}
+
+int m68k_memo_recording(void)
+{
+    return m68k_memo_active;
+}
+
+void m68k_memo_returned(void)
+{
+    if (m68k_memo_active) {
+        g_memo.rec.returned = true;
+        m68k_memo_active = 0;
+    }
+}
+
+void m68k_memo_end(int completed, unsigned long long cycles)
+{
+    Recording& rec = g_memo.rec;
+    if (rec.depth == 0 || --rec.depth > 0 || (!m68k_memo_active && !rec.returned)) {
+        return;
+    }
+
+    MemoSlot* slot = find_enabled_slot(rec.entry_pc);
+    if (slot) {
+        if (!completed || rec.overflow) {
+            slot->stats.rejected++;
+        } else {
+            rec.entry.outputs.capture();
+            rec.entry.out_pc = m68k_get_reg(nullptr, M68K_REG_PC);
+            rec.entry.out_ppc = m68k_get_reg(nullptr, M68K_REG_PPC);
+            rec.entry.cycles = cycles;
+            store_entry(*slot, std::move(rec.entry));
+        }
+    }
+    reset_recording();
+}
+
+void m68k_memo_record_read(unsigned int address, int size, unsigned int value)
+{
+    Recording& rec = g_memo.rec;
+    if (!m68k_memo_active || rec.overflow) {
+        return;
+    }
+    for (int i = 0; i < size; ++i) {
+        const uint32_t a = address + static_cast<uint32_t>(i);
+        if (rec.write_index.count(a) != 0 || !rec.read_seen.insert(a).second) {
+            continue;
+        }
+        if (is_return_fetch(a)) {
+            continue;
+        }
+        uint8_t unused;
+        if (!m68k_pagemap::peek(a, &unused)) {
+            /* Host and MMIO reads cannot be re-checked without side effects */
+            rec.overflow = true;
+            return;
+        }
+        const uint8_t byte = static_cast<uint8_t>(value >> ((size - 1 - i) * 8));
+        rec.entry.reads.emplace_back(a, byte);
+    }
+    rec.overflow = touched_too_much();
+}
+
+void m68k_memo_record_write(unsigned int address, int size, unsigned int value)
+{
+    Recording& rec = g_memo.rec;
+    if (!m68k_memo_active || rec.overflow) {
+        return;
+    }
+    for (int i = 0; i < size; ++i) {
+        const uint32_t a = address + static_cast<uint32_t>(i);
+        const uint8_t byte = static_cast<uint8_t>(value >> ((size - 1 - i) * 8));
+        auto it = rec.write_index.find(a);
+        if (it != rec.write_index.end()) {
+            rec.entry.writes[it->second].second = byte;
+        } else {
+            rec.write_index.emplace(a, rec.entry.writes.size());
+            rec.entry.writes.emplace_back(a, byte);
+        }
+    }
+    rec.overflow = touched_too_much();
+}
+
+} // extern "C"
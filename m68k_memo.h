@@ -0,0 +1,105 @@
+/* ======================================================================== */
+/* ===================== M68K GUEST CALL MEMOIZATION ===================== */
+/* ======================================================================== */
+
+#ifndef M68KMEMO__HEADER
+#define M68KMEMO__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Pass as entry_pc to query totals across all memoized entry points */
+#define M68K_MEMO_ALL 0xFFFFFFFFu
+
+/* Statistics snapshot (all fields uint32 for easy HEAPU32 access) */
+typedef struct m68k_memo_stats {
+    uint32_t hits;           /* Calls answered from the cache */
+    uint32_t misses;         /* Calls that had to execute */
+    uint32_t recorded;       /* Executions stored as new entries */
+    uint32_t rejected;       /* Executions not cacheable (non-sentinel exit, too large) */
+    uint32_t invalidated;    /* Entries dropped by invalidation */
+    uint32_t entries;        /* Entries currently cached */
+    uint32_t evicted;        /* Entries replaced to make room for new ones */
+} m68k_memo_stats_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Memoization applies to m68k_call_until_js_stop() calls of opted-in entry
+ * points. A cached entry is keyed by D0-D7/A0-A7/SR at entry and the bytes
+ * the call read before writing them (its read-set). A later call with the
+ * same registers whose read-set still holds the same values gets the
+ * recorded write-set, exit registers and cycle count applied without
+ * executing; host hooks inside the routine do not run on a hit. Only opt in
+ * routines that are pure functions of registers and memory. Calls that read
+ * anything outside direct region pages (host callbacks, MMIO) are rejected,
+ * since their read-set cannot be re-checked without side effects. Hits
+ * write through the memory bridge, so dirty pages, fingerprints and
+ * watchpoints see them. */
+
+/* Opt an entry point in or out (disabling drops its entries) */
+void m68k_memo_enable(unsigned int entry_pc);
+void m68k_memo_disable(unsigned int entry_pc);
+void m68k_memo_disable_all(void);
+
+/* Drop cached entries: for one entry point, all, or every entry whose
+ * read-set overlaps [start, start+size) (e.g. after reloading ROM) */
+void m68k_memo_invalidate(unsigned int entry_pc);
+void m68k_memo_invalidate_all(void);
+void m68k_memo_invalidate_range(unsigned int start, unsigned int size);
+
+/* Statistics for one entry point or M68K_MEMO_ALL. The returned pointer is
+ * refreshed on every call. */
+m68k_memo_stats_t* m68k_memo_stats_ptr(unsigned int entry_pc);
+void m68k_memo_reset_stats(void);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from myfunc.cc - not part of public API */
+
+/* Try to answer a call from the cache. On a hit the write-set and exit
+ * registers are applied, *cycles is set and 1 is returned. */
+int m68k_memo_lookup(unsigned int entry_pc, unsigned long long* cycles);
+
+/* Bracket an executed call; end stores the entry when completed != 0.
+ * return_pc is the sentinel the call returns to. */
+void m68k_memo_begin(unsigned int entry_pc, unsigned int return_pc);
+void m68k_memo_end(int completed, unsigned long long cycles);
+
+/* The call returned to its sentinel: stop recording so the fetch at the
+ * sentinel address and anything run after it stay out of the entry */
+void m68k_memo_returned(void);
+
+/* Non-zero while a call is being recorded (instruction fetches must then
+ * go through the bridge so code bytes join the read-set) */
+extern int m68k_memo_active;
+int m68k_memo_recording(void);
+
+/* Memory traffic while a call is being recorded */
+void m68k_memo_record_read(unsigned int address, int size, unsigned int value);
+void m68k_memo_record_write(unsigned int address, int size, unsigned int value);
+
+static inline void m68k_memo_note_read(unsigned int address, int size, unsigned int value)
+{
+    if (m68k_memo_active) {
+        m68k_memo_record_read(address, size, value);
+    }
+}
+
+static inline void m68k_memo_note_write(unsigned int address, int size, unsigned int value)
+{
+    if (m68k_memo_active) {
+        m68k_memo_record_write(address, size, value);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KMEMO__HEADER */
@@ -1,6 +1,13 @@
 // m68k_memory_bridge.cc - Bridge all M68k memory access through region-aware system
 #include <cstdint>
 
+#include "m68k_bridgestats.h"
+#include "m68k_dirty.h"
+#include "m68k_fetchcache.h"
+#include "m68k_fingerprint.h"
+#include "m68k_memo.h"
+#include "m68k_pagemap.h"
+
 // Your existing API (already implemented in myfunc.cc)
 extern "C" {
     unsigned int my_read_memory(unsigned int address, int size);
@@ -9,7 +16,7 @@ extern "C" {
 
 namespace {
 
-static inline uint32_t addr24(uint32_t a) { return a & 0x00FFFFFFu; }
+static inline uint32_t mask_address(uint32_t a) { return a & m68k_pagemap::g_address_mask; }
 
 template <unsigned int Size>
 constexpr unsigned int mask_for_size() {
@@ -23,16 +30,80 @@ constexpr unsigned int mask_for_size() {
     }
 }
 
+// Direct pages are served here; everything else takes the region scan and
+// host callbacks in my_read_memory / my_write_memory.
 template <unsigned int Size>
 unsigned int read_memory(unsigned int address) {
     static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
-    return my_read_memory(addr24(address), Size);
+    const uint32_t a = mask_address(address);
+    unsigned int value;
+    if (m68k_pagemap::read<Size>(a, &value)) {
+        m68k_bridge_note_read(M68K_BRIDGE_PATH_REGION, Size, a);
+    } else {
+        value = my_read_memory(a, Size);
+    }
+    m68k_memo_note_read(a, Size, value);
+    return value;
 }
 
 template <unsigned int Size>
 void write_memory(unsigned int address, unsigned int value) {
     static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
-    my_write_memory(addr24(address), Size, value & mask_for_size<Size>());
+    const uint32_t a = mask_address(address);
+    value &= mask_for_size<Size>();
+    m68k_memo_note_write(a, Size, value);
+    m68k_fingerprint_write(a, Size, value);
+    m68k_pagemap::note_dirty(a, Size);
+    if (m68k_pagemap::write<Size>(a, value)) {
+        m68k_bridge_note_write(M68K_BRIDGE_PATH_REGION, Size, a);
+        return;
+    }
+    my_write_memory(a, Size, value);
+}
+
+// A MOVEM run is served in one go only when it sits in one plain direct
+// page and nothing needs its accesses one by one: memo recording and
+// fingerprints see each value, and wait states are charged per access.
+// The counters and write observers are updated for the whole run here.
+template <bool Write>
+uint8_t* movem_span(unsigned int address, unsigned int count, unsigned int size) {
+    const uint32_t a = mask_address(address);
+    const uint32_t bytes = count * size;
+    if (!count || (a & 1) || (a & m68k_pagemap::kPageMask) + bytes > m68k_pagemap::kPageSize ||
+        m68k_memo_active || m68k_fingerprint_enabled) {
+        return nullptr;
+    }
+    const m68k_pagemap::Page& page = m68k_pagemap::page_for(a);
+    uint8_t* base = Write ? page.write : page.read;
+    if (!base || (page.flags & m68k_pagemap::kPageSwapped) || page.wait) {
+        return nullptr;
+    }
+    if constexpr (Write) {
+        m68k_pagemap::note_dirty(a, bytes);
+        if (m68k_pagemap::g_write_observer) {
+            m68k_pagemap::g_write_observer(a, static_cast<int>(bytes));
+        }
+        m68k_bridge_stats.writes[M68K_BRIDGE_PATH_REGION][size >> 1] += count;
+    } else {
+        m68k_bridge_stats.reads[M68K_BRIDGE_PATH_REGION][size >> 1] += count;
+    }
+    return base + (a & m68k_pagemap::kPageMask);
+}
+
+// Caches the fetch page when it is direct for reads. While a memo call is
+// recorded fetches stay on this path so code bytes join its read-set, and
+// pages with wait states stay on it so every fetch is charged.
+void refill_fetch_cache(uint32_t address) {
+    const uint32_t a = mask_address(address);
+    const m68k_pagemap::Page& page = m68k_pagemap::page_for(a);
+    if (!page.read || page.wait || m68k_memo_active) {
+        m68k_fetch_cache_invalidate();
+        return;
+    }
+    m68k_fetch_cache.base = page.read;
+    m68k_fetch_cache.mask = m68k_pagemap::g_address_mask;
+    m68k_fetch_cache.page = a & ~m68k_pagemap::kPageMask;
+    m68k_fetch_cache.swapped = (page.flags & m68k_pagemap::kPageSwapped) ? 1u : 0u;
 }
 
 }  // namespace
@@ -64,6 +135,14 @@ void m68k_write_memory_32(unsigned int address, unsigned int value) {
     write_memory<4>(address, value);
 }
 
+const unsigned char* m68k_movem_read_span(unsigned int address, unsigned int count, unsigned int size) {
+    return movem_span<false>(address, count, size);
+}
+
+unsigned char* m68k_movem_write_span(unsigned int address, unsigned int count, unsigned int size) {
+    return movem_span<true>(address, count, size);
+}
+
 // Predecrement write for move.l with -(An) destination
 void m68k_write_memory_32_pd(unsigned int address, unsigned int value) {
     // For proper 68k behavior, write high word first, then low word
@@ -72,41 +151,55 @@ void m68k_write_memory_32_pd(unsigned int address, unsigned int value) {
 }
 
 // ---- Instruction/immediate fetch + PC-relative + disassembler ----
-// Route *everything* through the same region-aware path.
+// Route *everything* through the same region-aware path. Only the
+// instruction stream counts as a fetch in the bridge statistics.
 unsigned int m68k_read_immediate_8(unsigned int address) { 
+    m68k_bridge_stats.fetches[0]++;
     return m68k_read_memory_8(address); 
 }
 
 unsigned int m68k_read_immediate_16(unsigned int address) { 
+    m68k_bridge_stats.fetches[1]++;
     return m68k_read_memory_16(address); 
 }
 
 unsigned int m68k_read_immediate_32(unsigned int address) { 
+    m68k_bridge_stats.fetches[2]++;
     return m68k_read_memory_32(address); 
 }
 
+unsigned int m68k_fetch_cache_miss_16(unsigned int address) {
+    refill_fetch_cache(address);
+    return m68k_read_immediate_16(address);
+}
+
+unsigned int m68k_fetch_cache_miss_32(unsigned int address) {
+    refill_fetch_cache(address);
+    return m68k_read_immediate_32(address);
+}
+
 unsigned int m68k_read_pcrelative_8(unsigned int address) { 
-    return m68k_read_immediate_8(address); 
+    return m68k_read_memory_8(address); 
 }
 
 unsigned int m68k_read_pcrelative_16(unsigned int address) { 
-    return m68k_read_immediate_16(address); 
+    return m68k_read_memory_16(address); 
 }
 
 unsigned int m68k_read_pcrelative_32(unsigned int address) { 
-    return m68k_read_immediate_32(address); 
+    return m68k_read_memory_32(address); 
 }
 
 unsigned int m68k_read_disassembler_8(unsigned int address) { 
-    return m68k_read_immediate_8(address); 
+    return m68k_read_memory_8(address); 
 }
 
 unsigned int m68k_read_disassembler_16(unsigned int address) { 
-    return m68k_read_immediate_16(address); 
+    return m68k_read_memory_16(address); 
 }
 
 unsigned int m68k_read_disassembler_32(unsigned int address) { 
-    return m68k_read_immediate_32(address); 
+    return m68k_read_memory_32(address); 
 }
 
 } // extern "C"
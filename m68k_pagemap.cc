@@ -0,0 +1,167 @@
+/* ======================================================================== */
+/* ======================= M68K DIRECT PAGE MAP ========================== */
+/* ======================================================================== */
+
+#include "m68k_pagemap.h"
+#include "m68k_fetchcache.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace m68k_pagemap {
+
+Page g_pages[kPageCount] = {};
+Page* g_blocks[kBlockCount] = {};
+uint32_t g_address_mask = 0x00FFFFFFu;
+void (*g_write_observer)(unsigned int address, int size) = nullptr;
+void (*g_wait_observer)(int owner, uint32_t cycles) = nullptr;
+
+namespace {
+
+constexpr uint64_t kAddressSpace = 1ull << 32;
+
+/* Shared by every unallocated block; never written */
+Page g_empty_block[kPageCount] = {};
+
+/* Storage for allocated blocks 1-255 */
+std::unique_ptr<Page[]> g_block_storage[kBlockCount];
+
+/* Pages (by 20-bit index) already claimed by a higher-priority region */
+std::bitset<kPageCount * kBlockCount> g_decided;
+
+struct BlockInit {
+    BlockInit() noexcept
+    {
+        g_blocks[0] = g_pages;
+        for (uint32_t block = 1; block < kBlockCount; ++block) {
+            g_blocks[block] = g_empty_block;
+        }
+    }
+} g_block_init;
+
+/* Writable entry for a 20-bit page index, allocating its block on first use */
+Page& page_at(uint32_t page) noexcept
+{
+    const uint32_t block = page >> (kBlockShift - kPageShift);
+    if (g_blocks[block] == g_empty_block) {
+        g_block_storage[block].reset(new Page[kPageCount]());
+        g_blocks[block] = g_block_storage[block].get();
+    }
+    return g_blocks[block][page & (kPageCount - 1)];
+}
+
+/* Mirror pages and the page they copy; kept so retarget() can refresh them */
+struct Alias {
+    uint32_t page;
+    uint32_t target;
+};
+std::vector<Alias> g_aliases;
+
+}  // namespace
+
+void clear() noexcept
+{
+    std::fill(std::begin(g_pages), std::end(g_pages), Page{});
+    for (uint32_t block = 1; block < kBlockCount; ++block) {
+        g_block_storage[block].reset();
+        g_blocks[block] = g_empty_block;
+    }
+    g_decided.reset();
+    g_aliases.clear();
+    m68k_fetch_cache_invalidate();
+}
+
+template <typename Fn>
+void for_each_undecided_page(uint32_t start, uint32_t size, Fn&& fn) noexcept
+{
+    const uint64_t begin = start;
+    const uint64_t end = std::min<uint64_t>(begin + size, kAddressSpace);
+    for (uint64_t page_base = begin & ~static_cast<uint64_t>(kPageMask); page_base < end;
+         page_base += kPageSize) {
+        const uint32_t page = static_cast<uint32_t>(page_base >> kPageShift);
+        if (g_decided[page]) {
+            continue;
+        }
+        g_decided[page] = true;
+        if (page_base >= begin && page_base + kPageSize <= end) {
+            fn(page, static_cast<uint32_t>(page_base - begin));
+        }
+    }
+}
+
+void add(uint32_t start, uint32_t size, uint8_t* read, uint8_t* write, uint32_t flags,
+         int owner, uint32_t wait) noexcept
+{
+    /* Slow-only pages (MMIO) keep the default entry, so they allocate nothing */
+    for_each_undecided_page(start, size, [&](uint32_t page, uint32_t offset) {
+        if (read || write) {
+            page_at(page) = Page{read ? read + offset : nullptr, write ? write + offset : nullptr,
+                                 flags, owner, g_wait_observer ? wait : 0, 0};
+        }
+    });
+}
+
+void alias(uint32_t start, uint32_t size, uint32_t target) noexcept
+{
+    const bool aligned = ((target - start) & kPageMask) == 0;
+    for_each_undecided_page(start, size, [&](uint32_t page, uint32_t offset) {
+        if (aligned) {
+            g_aliases.push_back({page, ((target + offset) & g_address_mask) >> kPageShift});
+        }
+    });
+}
+
+void resolve_aliases() noexcept
+{
+    for (const Alias& alias : g_aliases) {
+        const Page& target = page_for(alias.target << kPageShift);
+        const Page& current = page_for(alias.page << kPageShift);
+        if (!target.read && !target.write && !current.read && !current.write) {
+            continue;
+        }
+        Page& page = page_at(alias.page);
+        page.read = target.read;
+        page.write = target.write;
+        page.flags = target.flags;
+        page.owner = target.owner;      /* wait states are the target's */
+        page.wait = target.wait;
+        page.alias = target.alias + ((alias.target - alias.page) << kPageShift);
+    }
+}
+
+void retarget(int owner, uint32_t start, uint32_t size, uint8_t* read, uint8_t* write) noexcept
+{
+    const uint64_t begin = start;
+    const uint64_t end = std::min<uint64_t>(begin + size, kAddressSpace);
+    const uint64_t first = (begin + kPageMask) & ~static_cast<uint64_t>(kPageMask);
+    for (uint64_t page_base = first; page_base + kPageSize <= end; page_base += kPageSize) {
+        if (page_for(static_cast<uint32_t>(page_base)).owner != owner) {
+            continue;
+        }
+        Page& page = page_at(static_cast<uint32_t>(page_base >> kPageShift));
+        const uint64_t offset = page_base - begin;
+        page.read = read ? read + offset : nullptr;
+        page.write = write ? write + offset : nullptr;
+    }
+    if (!g_aliases.empty()) {
+        resolve_aliases();
+    }
+    m68k_fetch_cache_invalidate();
+}
+
+}  // namespace m68k_pagemap
+
+static_assert(M68K_FETCH_PAGE_SIZE == m68k_pagemap::kPageSize, "fetch cache pages are map pages");
+
+extern "C" {
+
+m68k_fetch_cache_t m68k_fetch_cache = {nullptr, 0x00FFFFFFu, 0, 0};
+
+void m68k_fetch_cache_invalidate(void)
+{
+    m68k_fetch_cache.base = nullptr;
+}
+
+}  // extern "C"
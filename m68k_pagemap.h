@@ -0,0 +1,276 @@
+/* ======================================================================== */
+/* ======================= M68K DIRECT PAGE MAP ========================== */
+/* ======================================================================== */
+/* Internal to the memory bridge: maps 4 KB guest pages that lie wholly
+ * inside a native region straight to host memory, so region accesses skip
+ * the region scan in my_read_memory / my_write_memory. Pages that are only
+ * partly covered, or not covered, stay null and take the full path.
+ *
+ * The map is two-level: 256 blocks of 16 MB. Block 0 (the whole 24-bit
+ * space) is a flat static table looked up without indirection; the other
+ * blocks are allocated only when a region lands in them, so sparse high
+ * mappings in a 32-bit space cost one table each. */
+
+#ifndef M68KPAGEMAP__HEADER
+#define M68KPAGEMAP__HEADER
+
+#include <cstdint>
+#include <cstring>
+
+#include "m68k_dirty.h"
+
+namespace m68k_pagemap {
+
+constexpr unsigned int kPageShift = 12;
+constexpr uint32_t kPageSize = 1u << kPageShift;
+constexpr uint32_t kPageMask = kPageSize - 1;
+constexpr uint32_t kPageCount = 1u << (24 - kPageShift);     /* Pages per block */
+constexpr unsigned int kBlockShift = 24;
+constexpr uint32_t kBlockCount = 1u << (32 - kBlockShift);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool kHostBigEndian = true;
+#else
+constexpr bool kHostBigEndian = false;
+#endif
+
+/* Backing store holds 16-bit words in host order (see add_region_swapped) */
+constexpr uint32_t kPageSwapped = 1u << 0;
+
+/* Host address of the page's first byte for reads / writes, or null */
+struct Page {
+    uint8_t* read;
+    uint8_t* write;
+    uint32_t flags;
+    int owner;          /* Handle of the region behind a direct page, 0 if none */
+    uint32_t wait;      /* Wait cycles per bus cycle, charged to owner */
+    uint32_t alias;     /* Guest distance to the page whose memory a mirror
+                         * page shares, 0 otherwise */
+};
+
+/* Block 0; g_blocks[0] points here. Unallocated blocks point at a shared
+ * table of null pages, so lookups never test for a missing block. */
+extern Page g_pages[kPageCount];
+extern Page* g_blocks[kBlockCount];
+
+/* Guest address width: 0x00FFFFFF (the default) or 0xFFFFFFFF */
+extern uint32_t g_address_mask;
+
+/* Called before every direct write when set; time travel installs it only
+ * while enabled with watchpoints, so other runs pay no call per write */
+extern void (*g_write_observer)(unsigned int address, int size);
+
+/* Called after every direct access to a page with wait states */
+extern void (*g_wait_observer)(int owner, uint32_t cycles);
+
+void clear() noexcept;
+
+/* Regions are added in lookup priority order after clear(). The first
+ * region touching a page decides it: the page is direct if that region
+ * covers it wholly, slow otherwise. read / write point at the byte for
+ * guest start; a null side always takes the slow path. */
+void add(uint32_t start, uint32_t size, uint8_t* read, uint8_t* write, uint32_t flags,
+         int owner, uint32_t wait) noexcept;
+
+/* Like add, but pages wholly inside [start, start + size) become copies of
+ * the page at the same offset from target once resolve_aliases() runs,
+ * provided target - start is page aligned */
+void alias(uint32_t start, uint32_t size, uint32_t target) noexcept;
+
+/* Call after the last add / alias; aliases resolve in the order added */
+void resolve_aliases() noexcept;
+
+/* Points owner's direct pages in [start, start + size) at new host memory
+ * and refreshes aliases; O(pages + aliases), no rebuild */
+void retarget(int owner, uint32_t start, uint32_t size, uint8_t* read, uint8_t* write) noexcept;
+
+template <unsigned int Size>
+inline uint32_t load_be(const uint8_t* p) noexcept
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
+    if constexpr (Size == 1) {
+        return *p;
+    } else if constexpr (Size == 2) {
+        uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return kHostBigEndian ? v : __builtin_bswap16(v);
+    } else {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return kHostBigEndian ? v : __builtin_bswap32(v);
+    }
+}
+
+template <unsigned int Size>
+inline void store_be(uint8_t* p, uint32_t value) noexcept
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
+    if constexpr (Size == 1) {
+        *p = static_cast<uint8_t>(value);
+    } else if constexpr (Size == 2) {
+        const uint16_t v = kHostBigEndian ? static_cast<uint16_t>(value)
+                                          : __builtin_bswap16(static_cast<uint16_t>(value));
+        std::memcpy(p, &v, sizeof(v));
+    } else {
+        const uint32_t v = kHostBigEndian ? value : __builtin_bswap32(value);
+        std::memcpy(p, &v, sizeof(v));
+    }
+}
+
+/* Word-swapped storage: base is the region (or page) start, which is
+ * guest-even, and offset is relative to it. Aligned words are native
+ * loads; bytes XOR the offset; odd words and longs go byte by byte. */
+inline uint32_t swapped_byte(const uint8_t* base, uint32_t offset) noexcept
+{
+    return base[offset ^ 1u];
+}
+
+template <unsigned int Size>
+inline uint32_t load_swapped(const uint8_t* base, uint32_t offset) noexcept
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
+    if constexpr (Size == 1) {
+        return swapped_byte(base, offset);
+    } else if constexpr (Size == 2) {
+        if ((offset & 1u) == 0) {
+            uint16_t v;
+            std::memcpy(&v, base + offset, sizeof(v));
+            return v;
+        }
+        return (swapped_byte(base, offset) << 8) | swapped_byte(base, offset + 1);
+    } else {
+        return (load_swapped<2>(base, offset) << 16) | load_swapped<2>(base, offset + 2);
+    }
+}
+
+template <unsigned int Size>
+inline void store_swapped(uint8_t* base, uint32_t offset, uint32_t value) noexcept
+{
+    static_assert(Size == 1 || Size == 2 || Size == 4, "Unsupported access size");
+    if constexpr (Size == 1) {
+        base[offset ^ 1u] = static_cast<uint8_t>(value);
+    } else if constexpr (Size == 2) {
+        if ((offset & 1u) == 0) {
+            const uint16_t v = static_cast<uint16_t>(value);
+            std::memcpy(base + offset, &v, sizeof(v));
+        } else {
+            store_swapped<1>(base, offset, value >> 8);
+            store_swapped<1>(base, offset + 1, value);
+        }
+    } else {
+        store_swapped<2>(base, offset, value >> 16);
+        store_swapped<2>(base, offset + 2, value);
+    }
+}
+
+/* Converts a big-endian image to host word order in place (or back) */
+inline void swap_words(uint8_t* data, uint32_t size) noexcept
+{
+    if (kHostBigEndian) {
+        return;
+    }
+    for (uint32_t i = 0; i + 1 < size; i += 2) {
+        const uint8_t t = data[i];
+        data[i] = data[i + 1];
+        data[i + 1] = t;
+    }
+}
+
+/* 16-bit bus cycles a Size-byte access takes */
+template <unsigned int Size>
+constexpr uint32_t bus_cycles() noexcept
+{
+    return Size == 4 ? 2 : 1;
+}
+
+/* Entry for a masked guest address; 24-bit addresses never leave block 0 */
+inline const Page& page_for(uint32_t address) noexcept
+{
+    const uint32_t block = address >> kBlockShift;
+    if (block == 0) {
+        return g_pages[address >> kPageShift];
+    }
+    return g_blocks[block][(address >> kPageShift) & (kPageCount - 1)];
+}
+
+/* Marks the dirty pages a direct write to [address, address + size)
+ * changes: its own and, on a mirror page, the target's */
+inline void note_dirty(uint32_t address, uint32_t size) noexcept
+{
+    if (!m68k_dirty_shift) {
+        return;
+    }
+    m68k_dirty_mark(address, size);
+    const uint32_t alias = page_for(address).alias;
+    if (alias) {
+        m68k_dirty_mark((address + alias) & g_address_mask, size);
+    }
+}
+
+/* Direct page for a Size-byte access at a masked address, or null when the
+ * page is not direct or the access runs off its end */
+template <unsigned int Size>
+inline const Page* lookup(uint32_t address, uint8_t* Page::*which) noexcept
+{
+    const Page& page = page_for(address);
+    if (!(page.*which) || (address & kPageMask) > kPageSize - Size) {
+        return nullptr;
+    }
+    return &page;
+}
+
+/* Byte at a masked address on a direct read page, without wait states;
+ * false when the page is not direct */
+inline bool peek(uint32_t address, uint8_t* value) noexcept
+{
+    const Page& page = page_for(address);
+    if (!page.read) {
+        return false;
+    }
+    const uint32_t offset = address & kPageMask;
+    *value = static_cast<uint8_t>((page.flags & kPageSwapped) ? load_swapped<1>(page.read, offset)
+                                                              : page.read[offset]);
+    return true;
+}
+
+template <unsigned int Size>
+inline bool read(uint32_t address, unsigned int* value) noexcept
+{
+    const Page* page = lookup<Size>(address, &Page::read);
+    if (!page) {
+        return false;
+    }
+    const uint32_t offset = address & kPageMask;
+    *value = (page->flags & kPageSwapped) ? load_swapped<Size>(page->read, offset)
+                                          : load_be<Size>(page->read + offset);
+    if (page->wait) {
+        g_wait_observer(page->owner, page->wait * bus_cycles<Size>());
+    }
+    return true;
+}
+
+template <unsigned int Size>
+inline bool write(uint32_t address, uint32_t value) noexcept
+{
+    const Page* page = lookup<Size>(address, &Page::write);
+    if (!page) {
+        return false;
+    }
+    if (g_write_observer) {
+        g_write_observer(address, Size);
+    }
+    const uint32_t offset = address & kPageMask;
+    if (page->flags & kPageSwapped) {
+        store_swapped<Size>(page->write, offset, value);
+    } else {
+        store_be<Size>(page->write + offset, value);
+    }
+    if (page->wait) {
+        g_wait_observer(page->owner, page->wait * bus_cycles<Size>());
+    }
+    return true;
+}
+
+}  // namespace m68k_pagemap
+
+#endif /* M68KPAGEMAP__HEADER */
@@ -6,6 +6,7 @@
 
 #include "m68k_perfetto.h"
 #include "m68k.h"
+#include "musashi_fault.h"
 #include <retrobus/retrobus_perfetto.hpp>
 
 #include <algorithm>
@@ -131,6 +132,29 @@ void m68k_perfetto_enable_instruction_registers(int enable) {
     }
 }
 
+void m68k_perfetto_enable_interrupts(int enable) {
+    if (g_tracer) {
+        g_tracer->enable_interrupt_tracing(enable != 0);
+    }
+}
+
+void m68k_perfetto_interrupt_event(unsigned int level, unsigned int vector,
+                                   uint64_t assert_cycles, uint64_t entry_cycles,
+                                   uint64_t end_cycles) {
+    if (!g_tracer || !g_tracer->interrupt_tracing_enabled()) {
+        return;
+    }
+    /* Both clocks advance together while tracing: shift onto the trace clock */
+    const int64_t offset = static_cast<int64_t>(m68k_get_total_cycles()) -
+                           static_cast<int64_t>(m68k_history_clock());
+    auto shift = [offset](uint64_t cycles) -> uint64_t {
+        const int64_t shifted = static_cast<int64_t>(cycles) + offset;
+        return shifted > 0 ? static_cast<uint64_t>(shifted) : 0;
+    };
+    g_tracer->handle_interrupt_event(level, vector, shift(assert_cycles),
+                                     shift(entry_cycles), shift(end_cycles));
+}
+
 int m68k_perfetto_export_trace(uint8_t** data_out, size_t* size_out) {
     if (!g_tracer || !data_out || !size_out) {
         return -1;
@@ -197,6 +221,7 @@ M68kPerfettoTracer::M68kPerfettoTracer(const std::string& process_name)
     , instruction_enabled_(false)
     , summary_slice_open_(false)
     , instruction_regs_enabled_(false)
+    , interrupts_enabled_(false)
     , total_instructions_(0)
     , total_memory_accesses_(0) {
     
@@ -209,6 +234,7 @@ M68kPerfettoTracer::M68kPerfettoTracer(const std::string& process_name)
     memory_writes_track_id_ = trace_builder_->add_thread("Writes");
     memory_counter_track_id_ = trace_builder_->add_counter_track("Memory_Access", "count");
     cycle_counter_track_id_ = trace_builder_->add_counter_track("CPU_Cycles", "cycles");
+    std::fill(std::begin(irq_track_ids_), std::end(irq_track_ids_), 0);
 }
 
 M68kPerfettoTracer::~M68kPerfettoTracer() {
@@ -434,6 +460,38 @@ int M68kPerfettoTracer::handle_memory_event(m68k_trace_mem_type type, uint32_t p
     return 0; /* Continue execution */
 }
 
+void M68kPerfettoTracer::handle_interrupt_event(unsigned int level, unsigned int vector,
+                                                uint64_t assert_cycles, uint64_t entry_cycles,
+                                                uint64_t end_cycles) {
+    if (!interrupts_enabled_ || level == 0 || level > 7) {
+        return;
+    }
+
+    if (irq_track_ids_[level] == 0) {
+        irq_track_ids_[level] = trace_builder_->add_thread("IRQ " + std::to_string(level));
+    }
+    const uint64_t track = irq_track_ids_[level];
+
+    /* Pending slice (assertion to handler entry), then the handler itself */
+    const uint64_t assert_ns = cycles_to_nanoseconds(assert_cycles);
+    const uint64_t entry_ns = cycles_to_nanoseconds(entry_cycles);
+    uint64_t end_ns = cycles_to_nanoseconds(end_cycles);
+    if (end_ns <= entry_ns) {
+        end_ns = entry_ns + 1;
+    }
+
+    if (entry_ns > assert_ns) {
+        trace_builder_->begin_slice(track, "pending", assert_ns)
+            .add_annotation("latency_cycles", static_cast<int64_t>(entry_cycles - assert_cycles));
+        trace_builder_->end_slice(track, entry_ns);
+    }
+
+    trace_builder_->begin_slice(track, "irq" + std::to_string(level), entry_ns)
+        .add_annotation("vector", static_cast<int64_t>(vector))
+        .add_annotation("handler_cycles", static_cast<int64_t>(end_cycles - entry_cycles));
+    trace_builder_->end_slice(track, end_ns);
+}
+
 int M68kPerfettoTracer::handle_instruction_event(uint32_t pc, uint16_t opcode, uint64_t start_cycles, int instr_cycles) {
     if (!instruction_enabled_) {
         return 0;
@@ -42,6 +42,12 @@ void m68k_perfetto_enable_flow(int enable);
 void m68k_perfetto_enable_memory(int enable);
 void m68k_perfetto_enable_instructions(int enable);
 void m68k_perfetto_enable_instruction_registers(int enable);
+void m68k_perfetto_enable_interrupts(int enable);
+
+/* Serviced interrupt (history cycle clock timestamps, see m68k_irqlat.h) */
+void m68k_perfetto_interrupt_event(unsigned int level, unsigned int vector,
+                                   uint64_t assert_cycles, uint64_t entry_cycles,
+                                   uint64_t end_cycles);
 
 /* Export trace data (critical for WASM) */
 int m68k_perfetto_export_trace(uint8_t** data_out, size_t* size_out);
@@ -79,6 +85,8 @@ public:
     void enable_memory_tracing(bool enable) { memory_enabled_ = enable; }
     void enable_instruction_tracing(bool enable);
     void enable_instruction_registers(bool enable) { instruction_regs_enabled_ = enable; }
+    void enable_interrupt_tracing(bool enable) { interrupts_enabled_ = enable; }
+    bool interrupt_tracing_enabled() const { return interrupts_enabled_; }
     
     /* Force cleanup of unclosed slices */
     void cleanup_unclosed_slices();
@@ -95,6 +103,10 @@ public:
 
     int handle_instruction_event(uint32_t pc, uint16_t opcode, uint64_t start_cycles, int instr_cycles);
 
+    void handle_interrupt_event(unsigned int level, unsigned int vector,
+                                uint64_t assert_cycles, uint64_t entry_cycles,
+                                uint64_t end_cycles);
+
     /* Export functionality */
     std::vector<uint8_t> serialize() const;
     void save_to_file(const std::string& filename) const;
@@ -108,6 +120,7 @@ private:
     uint64_t memory_writes_track_id_;
     uint64_t memory_counter_track_id_;
     uint64_t cycle_counter_track_id_;
+    uint64_t irq_track_ids_[8];  /* Per-level tracks, created on first use */
 
     /* Feature flags */
     bool flow_enabled_;
@@ -115,6 +128,7 @@ private:
     bool instruction_enabled_;
     bool summary_slice_open_;
     bool instruction_regs_enabled_;
+    bool interrupts_enabled_;
 
     /* Internal state for flow tracking */
     struct FlowState {
@@ -156,6 +170,12 @@ static inline void m68k_perfetto_enable_flow(int enable) { (void)enable; }
 static inline void m68k_perfetto_enable_memory(int enable) { (void)enable; }
 static inline void m68k_perfetto_enable_instructions(int enable) { (void)enable; }
 static inline void m68k_perfetto_enable_instruction_registers(int enable) { (void)enable; }
+static inline void m68k_perfetto_enable_interrupts(int enable) { (void)enable; }
+static inline void m68k_perfetto_interrupt_event(unsigned int level, unsigned int vector,
+                                                 uint64_t assert_cycles, uint64_t entry_cycles,
+                                                 uint64_t end_cycles) {
+    (void)level; (void)vector; (void)assert_cycles; (void)entry_cycles; (void)end_cycles;
+}
 static inline int m68k_perfetto_export_trace(uint8_t** data_out, size_t* size_out) { 
     (void)data_out; (void)size_out; return -1; 
 }
@@ -0,0 +1,146 @@
+/* ======================================================================== */
+/* ========================= M68K NATIVE REGIONS ========================= */
+/* ======================================================================== */
+/* Native memory regions are checked before any host callback. They are
+ * implemented in myfunc.cc; the first region added wins where regions
+ * overlap. */
+
+#ifndef M68KREGIONS__HEADER
+#define M68KREGIONS__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef enum {
+    M68K_REGION_RAM = 0,            /* Host buffer, read/write */
+    M68K_REGION_ROM = 1,            /* Host buffer, writes dropped or faulted */
+    M68K_REGION_MIRROR = 2,         /* Alias of another guest address range */
+    M68K_REGION_MMIO = 3            /* Native device handlers */
+} m68k_region_kind;
+
+/* What a ROM region does with writes */
+#define M68K_ROM_WRITE_IGNORE 0
+#define M68K_ROM_WRITE_FAULT  1     /* Bus error while executing, else ignored */
+
+/* What an access no region claims does. Only M68K_UNMAPPED_HOST reaches the
+ * host callbacks; the others read the open-bus value and drop writes. */
+#define M68K_UNMAPPED_HOST      0   /* JS or legacy callbacks (the default) */
+#define M68K_UNMAPPED_OPEN_BUS  1
+#define M68K_UNMAPPED_BUS_ERROR 2   /* Bus error while executing */
+#define M68K_UNMAPPED_BREAK     3   /* m68k_execute returns after the instruction */
+
+/* MMIO handlers get the offset from the region start. A missing size is
+ * split into two accesses of the next smaller size (big-endian); with no
+ * handler at any smaller size reads return 0 and writes are dropped. */
+typedef unsigned int (*m68k_mmio_read_t)(void* context, unsigned int offset);
+typedef void (*m68k_mmio_write_t)(void* context, unsigned int offset, unsigned int value);
+
+typedef struct m68k_mmio_handlers {
+    m68k_mmio_read_t read8;
+    m68k_mmio_read_t read16;
+    m68k_mmio_read_t read32;
+    m68k_mmio_write_t write8;
+    m68k_mmio_write_t write16;
+    m68k_mmio_write_t write32;
+} m68k_mmio_handlers_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Guest address width seen by regions, host callbacks and PC hooks: 24
+ * (the default; addresses wrap at 16 MB as on the 68000) or 32 for
+ * 68020+ code using the full 4 GB space. Regions above 16 MB are only
+ * reachable at width 32. Register PC hooks after changing the width.
+ * Returns 0, or -1 for any other width. */
+int m68k_set_address_width(int bits);
+int m68k_get_address_width(void);
+
+/* Every add returns a handle (> 0) or -1 on invalid arguments. Regions do
+ * not own their buffers. */
+int add_region(unsigned int start, unsigned int size, void* data);
+int add_region_swapped(unsigned int start, unsigned int size, void* data);
+int add_rom_region(unsigned int start, unsigned int size, void* data, int write_policy);
+
+/* [start, start + size) reads and writes [target, target + size) through
+ * the full lookup, so mirrors of regions, devices and host callbacks all
+ * work. Page-aligned mirrors of direct pages alias the same host memory. */
+int add_mirror_region(unsigned int start, unsigned int size, unsigned int target);
+
+/* A window of window_size bytes at start onto a larger backing buffer,
+ * initially at offset 0. kind is M68K_REGION_RAM or M68K_REGION_ROM (writes
+ * ignored). remap_bank moves the window by repointing its pages and any
+ * page-aligned mirrors of them: nothing is copied or rebuilt. Returns 0, or
+ * -1 for an unknown or unbanked handle or an offset past the backing end. */
+int add_banked_region(unsigned int start, unsigned int window_size, void* backing,
+                      unsigned int backing_size, int kind);
+int remap_bank(int handle, unsigned int backing_offset);
+
+/* handlers is copied */
+int add_mmio_region(unsigned int start, unsigned int size,
+                    const m68k_mmio_handlers_t* handlers, void* context);
+
+/* Returns 0, or -1 for an unknown handle */
+int remove_region(int handle);
+void clear_regions(void);
+
+/* Unmapped policy for every 4 KB page touching [start, start + size);
+ * pages never set follow set_unmapped_default. Bus errors are recorded with
+ * the faulting address and size (extra is 1 for writes) in the fault record;
+ * breaks report reason 6 from m68k_get_last_break_reason. Accesses outside
+ * m68k_execute read open bus under any non-host policy. Policies survive
+ * clear_regions. Both return 0, or -1 for an unknown policy. */
+int set_unmapped_policy(unsigned int start, unsigned int size, int policy);
+int set_unmapped_default(int policy);
+
+/* Word seen on an open bus (default 0xFFFF): bytes read its high or low
+ * half by address parity, longs read it twice */
+void set_open_bus_value(unsigned int word);
+
+/* Last access that hit a non-host page: returns 1 for a write, 0 for a
+ * read, or -1 if there has been none */
+int get_last_unmapped_access(unsigned int* address, unsigned int* size);
+
+/* Copy length guest bytes to / from a host buffer, as the guest would see
+ * them. Direct region pages are copied with memcpy; other pages go byte by
+ * byte through regions and host callbacks. These are host accesses and
+ * raise no trace events. Returns 0, or -1 for a null buffer. */
+int read_block(unsigned int address, unsigned int length, void* dst);
+int write_block(unsigned int address, unsigned int length, const void* src);
+
+/* Extra cycles each bus cycle to the region costs while executing; longs
+ * are two 16-bit bus cycles. m68k_execute budgets and m68k_cycles_run
+ * include them. Mirrors pay their target's wait states. Returns 0, or -1
+ * for an unknown handle or a mirror. */
+int set_region_wait_states(int handle, unsigned int wait);
+
+/* Wait cycles charged to the region since the last reset, split into
+ * 32-bit halves. Returns 0, or -1 for an unknown handle. */
+int get_region_wait_cycles(int handle, uint32_t* lo, uint32_t* hi);
+void reset_wait_cycles(void);
+
+/* Pages of the region written since their dirty bits were last cleared
+ * (see m68k_dirty.h); 0 while tracking is off, -1 for an unknown handle */
+int get_region_dirty_pages(int handle);
+
+/* Introspection by index in lookup order. data is NULL for mirrors and
+ * MMIO regions; get_region_swapped is 1 for host word order buffers. */
+unsigned int get_region_count(void);
+int get_region_info(unsigned int index, unsigned int* start, unsigned int* size, void** data);
+int get_region_kind(unsigned int index);
+int get_region_handle(unsigned int index);
+int get_region_swapped(unsigned int index);
+/* Backing buffer of a banked region and the window's current offset into
+ * it (data from get_region_info is the window). Returns 0, or -1 for an
+ * unbanked region or a bad index. */
+int get_region_bank(unsigned int index, void** backing, unsigned int* backing_size,
+                    unsigned int* backing_offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KREGIONS__HEADER */
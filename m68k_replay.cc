@@ -0,0 +1,579 @@
+/* ======================================================================== */
+/* ===================== M68K DETERMINISTIC RECORD/REPLAY ================= */
+/* ======================================================================== */
+
+#include "m68k_replay.h"
+#include "m68k.h"
+#include "m68kcpu.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+int m68k_replay_active = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+constexpr uint8_t kLogMagic[4] = {'M', '6', '8', 'R'};
+constexpr uint8_t kLogVersion = 1;
+constexpr size_t kHeaderSize = sizeof(kLogMagic) + 1;
+
+constexpr uint8_t kTagKindMask = 0x0F;
+constexpr uint8_t kTagOutside = 0x10;
+constexpr unsigned kTagSizeShift = 5;
+
+constexpr uint64_t kNoLivePosition = ~0ULL;
+
+/* Decoded event (absolute positions) */
+struct ReplayEvent {
+    m68k_replay_event_kind kind;
+    bool outside;
+    int size;
+    uint64_t instr;
+    uint64_t cycle;
+    uint32_t address;
+    uint32_t value;
+};
+
+struct m68k_replay_state {
+    m68k_replay_mode mode = M68K_REPLAY_OFF;
+    std::vector<uint8_t> log;
+
+    /* Execution clock: instructions started and cycles consumed */
+    uint64_t instr = 0;
+    uint64_t cycle_base = 0;
+
+    /* True while inside m68k_execute() or a logged reset */
+    bool capturing = false;
+    bool reset_saved_capturing = false;
+    /* True while playback re-issues a logged IRQ/reset through the public API */
+    bool applying = false;
+
+    /* Delta-encoding anchors (shared by writer and reader) */
+    uint64_t last_instr = 0;
+    uint64_t last_cycle = 0;
+    uint64_t events = 0;
+
+    /* Playback cursor and one-event lookahead */
+    size_t cursor = 0;
+    bool has_pending = false;
+    ReplayEvent pending{};
+    bool finished = false;
+    bool diverged = false;
+
+    /* Time travel: hand playback back to recording at this position */
+    uint64_t live_position = kNoLivePosition;
+    m68k_replay_boundary_hook_t boundary_hook = nullptr;
+};
+
+m68k_replay_state g_replay;
+
+void set_mode(m68k_replay_mode mode) noexcept
+{
+    g_replay.mode = mode;
+    m68k_replay_active = mode != M68K_REPLAY_OFF;
+}
+
+inline uint64_t current_cycle() noexcept
+{
+    uint64_t now = g_replay.cycle_base;
+    if (g_replay.capturing) {
+        const int run = m68k_cycles_run();
+        if (run > 0) {
+            now += static_cast<uint64_t>(run);
+        }
+    }
+    return now;
+}
+
+inline uint8_t size_code(int size) noexcept
+{
+    return size == 4 ? 2 : (size == 2 ? 1 : 0);
+}
+
+inline int size_from_code(uint8_t code) noexcept
+{
+    return code == 2 ? 4 : (code == 1 ? 2 : 1);
+}
+
+/* ======================================================================== */
+/* ============================ LOG ENCODING ============================= */
+/* ======================================================================== */
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool get_varint(uint64_t& value) noexcept
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (g_replay.cursor >= g_replay.log.size()) {
+            return false;
+        }
+        const uint8_t byte = g_replay.log[g_replay.cursor++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void append_event(m68k_replay_event_kind kind, int size, uint32_t address, uint32_t value)
+{
+    uint64_t cycle = current_cycle();
+    if (cycle < g_replay.last_cycle) {
+        cycle = g_replay.last_cycle;
+    }
+
+    uint8_t tag = static_cast<uint8_t>(kind);
+    if (!g_replay.capturing) {
+        tag |= kTagOutside;
+    }
+    tag |= static_cast<uint8_t>(size_code(size) << kTagSizeShift);
+    g_replay.log.push_back(tag);
+    put_varint(g_replay.log, g_replay.instr - g_replay.last_instr);
+    put_varint(g_replay.log, cycle - g_replay.last_cycle);
+    if (kind == M68K_REPLAY_EVENT_READ) {
+        put_varint(g_replay.log, address);
+        put_varint(g_replay.log, value);
+    } else if (kind == M68K_REPLAY_EVENT_IRQ) {
+        put_varint(g_replay.log, value);
+    }
+
+    g_replay.last_instr = g_replay.instr;
+    g_replay.last_cycle = cycle;
+    ++g_replay.events;
+}
+
+/* Decode the next event into the lookahead slot. Returns false at end of log. */
+bool peek_event() noexcept
+{
+    if (g_replay.has_pending) {
+        return true;
+    }
+    if (g_replay.cursor >= g_replay.log.size()) {
+        return false;
+    }
+
+    const uint8_t tag = g_replay.log[g_replay.cursor++];
+    uint64_t instr_delta = 0;
+    uint64_t cycle_delta = 0;
+    if (!get_varint(instr_delta) || !get_varint(cycle_delta)) {
+        return false;
+    }
+
+    ReplayEvent ev{};
+    ev.kind = static_cast<m68k_replay_event_kind>(tag & kTagKindMask);
+    ev.outside = (tag & kTagOutside) != 0;
+    ev.size = size_from_code(static_cast<uint8_t>((tag >> kTagSizeShift) & 0x3));
+    ev.instr = g_replay.last_instr + instr_delta;
+    ev.cycle = g_replay.last_cycle + cycle_delta;
+
+    uint64_t field = 0;
+    if (ev.kind == M68K_REPLAY_EVENT_READ) {
+        if (!get_varint(field)) return false;
+        ev.address = static_cast<uint32_t>(field);
+        if (!get_varint(field)) return false;
+        ev.value = static_cast<uint32_t>(field);
+    } else if (ev.kind == M68K_REPLAY_EVENT_IRQ) {
+        if (!get_varint(field)) return false;
+        ev.value = static_cast<uint32_t>(field);
+    }
+
+    g_replay.last_instr = ev.instr;
+    g_replay.last_cycle = ev.cycle;
+    g_replay.pending = ev;
+    g_replay.has_pending = true;
+    return true;
+}
+
+inline void consume_event() noexcept
+{
+    g_replay.has_pending = false;
+    ++g_replay.events;
+}
+
+void mark_diverged() noexcept
+{
+    g_replay.diverged = true;
+    m68k_end_timeslice();
+}
+
+/* Re-issue a logged control event (IRQ, reset, deferred interrupt check) */
+void apply_control_event(const ReplayEvent& ev)
+{
+    switch (ev.kind) {
+        case M68K_REPLAY_EVENT_IRQ:
+            g_replay.applying = true;
+            m68k_set_irq(ev.value);
+            g_replay.applying = false;
+            break;
+        case M68K_REPLAY_EVENT_RESET:
+            g_replay.applying = true;
+            m68k_pulse_reset();
+            g_replay.applying = false;
+            break;
+        case M68K_REPLAY_EVENT_INT_CHECK:
+            m68ki_check_interrupts();
+            break;
+        default:
+            break;
+    }
+}
+
+void reset_clock() noexcept
+{
+    g_replay.instr = 0;
+    g_replay.cycle_base = 0;
+    g_replay.capturing = false;
+    g_replay.applying = false;
+    g_replay.last_instr = 0;
+    g_replay.last_cycle = 0;
+    g_replay.events = 0;
+    g_replay.cursor = 0;
+    g_replay.has_pending = false;
+    g_replay.finished = false;
+    g_replay.diverged = false;
+    g_replay.live_position = kNoLivePosition;
+}
+
+/* Playback caught up with the end of a rewound recording: keep recording */
+bool maybe_go_live() noexcept
+{
+    if (g_replay.live_position == kNoLivePosition ||
+        g_replay.instr < g_replay.live_position || peek_event()) {
+        return false;
+    }
+    set_mode(M68K_REPLAY_RECORDING);
+    g_replay.live_position = kNoLivePosition;
+    return true;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+void m68k_replay_start_recording(void)
+{
+    reset_clock();
+    g_replay.log.assign(kLogMagic, kLogMagic + sizeof(kLogMagic));
+    g_replay.log.push_back(kLogVersion);
+    set_mode(M68K_REPLAY_RECORDING);
+}
+
+int m68k_replay_start_playback(const uint8_t* data, size_t size)
+{
+    if (!data || size < kHeaderSize ||
+        std::memcmp(data, kLogMagic, sizeof(kLogMagic)) != 0 ||
+        data[sizeof(kLogMagic)] != kLogVersion) {
+        return -1;
+    }
+    reset_clock();
+    g_replay.log.assign(data, data + size);
+    g_replay.cursor = kHeaderSize;
+    set_mode(M68K_REPLAY_PLAYING);
+    return 0;
+}
+
+void m68k_replay_stop(void)
+{
+    if (g_replay.mode == M68K_REPLAY_RECORDING) {
+        const bool saved = g_replay.capturing;
+        g_replay.capturing = false;
+        append_event(M68K_REPLAY_EVENT_END, 1, 0, 0);
+        g_replay.capturing = saved;
+    }
+    set_mode(M68K_REPLAY_OFF);
+    g_replay.capturing = false;
+    g_replay.has_pending = false;
+}
+
+int m68k_replay_get_mode(void)
+{
+    return static_cast<int>(g_replay.mode);
+}
+
+const uint8_t* m68k_replay_log_data(void)
+{
+    return g_replay.log.empty() ? nullptr : g_replay.log.data();
+}
+
+size_t m68k_replay_log_size(void)
+{
+    return g_replay.log.size();
+}
+
+uint64_t m68k_replay_event_count(void)
+{
+    return g_replay.events;
+}
+
+uint64_t m68k_replay_position(void)
+{
+    return g_replay.instr;
+}
+
+int m68k_replay_finished(void)
+{
+    return g_replay.finished ? 1 : 0;
+}
+
+int m68k_replay_diverged(void)
+{
+    return g_replay.diverged ? 1 : 0;
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+int m68k_replay_execute_begin(void)
+{
+    switch (g_replay.mode) {
+        case M68K_REPLAY_RECORDING:
+            /* Entry checks are where host-timed IRQs get taken; log the ones
+             * that can fire so playback takes them at the same instruction. */
+            if (m68ki_cpu.nmi_pending || CPU_INT_LEVEL > FLAG_INT_MASK) {
+                append_event(M68K_REPLAY_EVENT_INT_CHECK, 1, 0, 0);
+            }
+            g_replay.capturing = true;
+            return 1;
+        case M68K_REPLAY_PLAYING:
+            if (maybe_go_live()) {
+                return m68k_replay_execute_begin();
+            }
+            g_replay.capturing = true;
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+void m68k_replay_execute_end(int cycles_used)
+{
+    if (g_replay.mode == M68K_REPLAY_OFF) {
+        return;
+    }
+    g_replay.capturing = false;
+    if (cycles_used > 0) {
+        g_replay.cycle_base += static_cast<uint64_t>(cycles_used);
+    }
+}
+
+int m68k_replay_instruction_boundary(void)
+{
+    if (g_replay.mode == M68K_REPLAY_RECORDING) {
+        if (g_replay.boundary_hook && g_replay.boundary_hook(g_replay.instr)) {
+            return 1;
+        }
+        ++g_replay.instr;
+        return 0;
+    }
+    if (g_replay.mode != M68K_REPLAY_PLAYING) {
+        return 0;
+    }
+    if (g_replay.finished || g_replay.diverged) {
+        return 1;
+    }
+
+    /* Apply every control event that happened before this instruction started */
+    while (peek_event()) {
+        const ReplayEvent ev = g_replay.pending;
+        if (ev.kind == M68K_REPLAY_EVENT_READ || ev.instr > g_replay.instr) {
+            break;
+        }
+        if (ev.kind == M68K_REPLAY_EVENT_END) {
+            g_replay.finished = true;
+            return 1;
+        }
+        consume_event();
+        apply_control_event(ev);
+    }
+
+    maybe_go_live();
+    if (g_replay.boundary_hook && g_replay.boundary_hook(g_replay.instr)) {
+        return 1;
+    }
+    ++g_replay.instr;
+    return 0;
+}
+
+int m68k_replay_note_irq(unsigned int int_level)
+{
+    if (g_replay.applying) {
+        return 1;
+    }
+    switch (g_replay.mode) {
+        case M68K_REPLAY_RECORDING:
+            append_event(M68K_REPLAY_EVENT_IRQ, 1, 0, int_level);
+            return 1;
+        case M68K_REPLAY_PLAYING:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+int m68k_replay_reset_begin(void)
+{
+    if (g_replay.mode == M68K_REPLAY_PLAYING && !g_replay.applying) {
+        return 0;
+    }
+    if (g_replay.mode == M68K_REPLAY_RECORDING && !g_replay.applying) {
+        append_event(M68K_REPLAY_EVENT_RESET, 1, 0, 0);
+    }
+    /* Vector fetches during reset are part of the replayed input stream */
+    g_replay.reset_saved_capturing = g_replay.capturing;
+    if (g_replay.mode != M68K_REPLAY_OFF) {
+        g_replay.capturing = true;
+    }
+    return 1;
+}
+
+void m68k_replay_reset_end(void)
+{
+    g_replay.capturing = g_replay.reset_saved_capturing;
+}
+
+int m68k_replay_fetch_read(unsigned int address, int size, unsigned int* value)
+{
+    if (g_replay.mode != M68K_REPLAY_PLAYING || !g_replay.capturing) {
+        return 0;
+    }
+    *value = 0;
+    if (g_replay.diverged) {
+        return 1;
+    }
+
+    /* Control events logged ahead of this read happened first */
+    while (peek_event() && g_replay.pending.kind != M68K_REPLAY_EVENT_READ) {
+        if (g_replay.pending.kind == M68K_REPLAY_EVENT_END) {
+            break;
+        }
+        const ReplayEvent ev = g_replay.pending;
+        consume_event();
+        apply_control_event(ev);
+    }
+
+    if (!peek_event() ||
+        g_replay.pending.kind != M68K_REPLAY_EVENT_READ ||
+        g_replay.pending.address != address ||
+        g_replay.pending.size != size) {
+        mark_diverged();
+        return 1;
+    }
+
+    *value = g_replay.pending.value;
+    consume_event();
+    return 1;
+}
+
+void m68k_replay_log_read(unsigned int address, int size, unsigned int value)
+{
+    if (g_replay.mode == M68K_REPLAY_RECORDING && g_replay.capturing) {
+        append_event(M68K_REPLAY_EVENT_READ, size, address, value);
+    }
+}
+
+int m68k_replay_is_playing(void)
+{
+    return (g_replay.mode == M68K_REPLAY_PLAYING && g_replay.capturing) ? 1 : 0;
+}
+
+/* ======================================================================== */
+/* ======================= TIME TRAVEL SUPPORT ============================ */
+/* ======================================================================== */
+
+void m68k_replay_set_boundary_hook(m68k_replay_boundary_hook_t hook)
+{
+    g_replay.boundary_hook = hook;
+}
+
+int m68k_replay_save_cursor(m68k_replay_cursor* cursor)
+{
+    if (!cursor || g_replay.mode != M68K_REPLAY_RECORDING) {
+        return -1;
+    }
+    cursor->offset = g_replay.log.size();
+    cursor->position = g_replay.instr;
+    cursor->cycle = current_cycle();
+    cursor->last_position = g_replay.last_instr;
+    cursor->last_cycle = g_replay.last_cycle;
+    cursor->events = g_replay.events;
+    return 0;
+}
+
+int m68k_replay_rewind(const m68k_replay_cursor* cursor, uint64_t live_position)
+{
+    if (!cursor || g_replay.mode == M68K_REPLAY_OFF ||
+        cursor->offset < kHeaderSize || cursor->offset > g_replay.log.size()) {
+        return -1;
+    }
+    reset_clock();
+    g_replay.cursor = cursor->offset;
+    g_replay.instr = cursor->position;
+    g_replay.cycle_base = cursor->cycle;
+    g_replay.last_instr = cursor->last_position;
+    g_replay.last_cycle = cursor->last_cycle;
+    g_replay.events = cursor->events;
+    g_replay.live_position = live_position;
+    set_mode(M68K_REPLAY_PLAYING);
+    maybe_go_live();
+    return 0;
+}
+
+uint64_t m68k_replay_cycle(void)
+{
+    return current_cycle();
+}
+
+size_t m68k_replay_export_slice(const m68k_replay_cursor* from, const m68k_replay_cursor* to,
+                                uint8_t* out, size_t capacity)
+{
+    if (!from || !to || from->offset < kHeaderSize || from->offset > to->offset ||
+        to->offset > g_replay.log.size() || to->position < to->last_position ||
+        to->cycle < to->last_cycle) {
+        return 0;
+    }
+
+    std::vector<uint8_t> slice(kLogMagic, kLogMagic + sizeof(kLogMagic));
+    slice.push_back(kLogVersion);
+    slice.insert(slice.end(), g_replay.log.begin() + from->offset, g_replay.log.begin() + to->offset);
+    slice.push_back(static_cast<uint8_t>(M68K_REPLAY_EVENT_END | kTagOutside));
+    put_varint(slice, to->position - to->last_position);
+    put_varint(slice, to->cycle - to->last_cycle);
+
+    if (out && capacity >= slice.size()) {
+        std::memcpy(out, slice.data(), slice.size());
+    }
+    return slice.size();
+}
+
+int m68k_replay_start_playback_at(const uint8_t* data, size_t size, const m68k_replay_cursor* start)
+{
+    if (!start || m68k_replay_start_playback(data, size) != 0) {
+        return -1;
+    }
+    g_replay.instr = start->position;
+    g_replay.cycle_base = start->cycle;
+    g_replay.last_instr = start->last_position;
+    g_replay.last_cycle = start->last_cycle;
+    g_replay.events = start->events;
+    return 0;
+}
+
+} // extern "C"
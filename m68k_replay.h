@@ -0,0 +1,155 @@
+/* ======================================================================== */
+/* ===================== M68K DETERMINISTIC RECORD/REPLAY ================= */
+/* ======================================================================== */
+
+#ifndef M68KREPLAY__HEADER
+#define M68KREPLAY__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ======================================================================== */
+/* ============================ ENUMERATIONS ============================= */
+/* ======================================================================== */
+
+typedef enum {
+    M68K_REPLAY_OFF = 0,
+    M68K_REPLAY_RECORDING,
+    M68K_REPLAY_PLAYING
+} m68k_replay_mode;
+
+/* Event kinds stored in the log (low nibble of each event's tag byte) */
+typedef enum {
+    M68K_REPLAY_EVENT_READ = 1,         /* Host-backed or MMIO region read result */
+    M68K_REPLAY_EVENT_IRQ = 2,          /* m68k_set_irq() level change */
+    M68K_REPLAY_EVENT_RESET = 3,        /* m68k_pulse_reset() */
+    M68K_REPLAY_EVENT_INT_CHECK = 4,    /* m68k_execute() entry that could take an interrupt */
+    M68K_REPLAY_EVENT_END = 5           /* End of recording */
+} m68k_replay_event_kind;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Log format
+ * A 5-byte header ("M68R" + version) followed by variable-length events:
+ *   tag      - kind (bits 0-3), outside-execute flag (bit 4), size code (bits 5-6)
+ *   varint   - instructions started since the previous event
+ *   varint   - cycles since the previous event
+ *   payload  - READ: varint address, varint value; IRQ: varint level
+ * Event positions are instruction counts, so a log replays identically no
+ * matter how the host slices m68k_execute() calls.
+ */
+
+/* Start recording a fresh log. The CPU and memory state at this point is the
+ * replay starting point; the host is responsible for restoring it before
+ * playback (the log only carries external inputs). */
+void m68k_replay_start_recording(void);
+
+/* Start playback of a log previously produced by a recording.
+ * The data is copied. Returns 0 on success, -1 if the header is invalid. */
+int m68k_replay_start_playback(const uint8_t* data, size_t size);
+
+/* Stop recording (appends the END marker) or playback */
+void m68k_replay_stop(void);
+
+/* Current mode (m68k_replay_mode) */
+int m68k_replay_get_mode(void);
+
+/* Access the recorded log (valid until the next start/stop call) */
+const uint8_t* m68k_replay_log_data(void);
+size_t m68k_replay_log_size(void);
+
+/* Number of events recorded or consumed so far */
+uint64_t m68k_replay_event_count(void);
+
+/* Instructions started since recording/playback began */
+uint64_t m68k_replay_position(void);
+
+/* Playback status: non-zero once the END marker has been reached */
+int m68k_replay_finished(void);
+
+/* Playback status: non-zero if the run requested an input the log does not
+ * contain (different address/size or log exhausted). Execution is stopped
+ * at the point of divergence. */
+int m68k_replay_diverged(void);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the CPU core and myfunc.cc - not part of public API */
+
+/* m68k_execute() entry/exit. Begin returns 0 when the core must skip its
+ * entry interrupt check (playback applies it at the recorded instruction). */
+int m68k_replay_execute_begin(void);
+void m68k_replay_execute_end(int cycles_used);
+
+/* Called before each instruction fetch while m68k_replay_active is set.
+ * Returns non-zero to stop the execute loop before the instruction starts. */
+extern int m68k_replay_active;
+int m68k_replay_instruction_boundary(void);
+
+/* IRQ/reset notifications. Return 0 when the host call must be ignored
+ * (during playback the log owns these inputs). */
+int m68k_replay_note_irq(unsigned int int_level);
+int m68k_replay_reset_begin(void);
+void m68k_replay_reset_end(void);
+
+/* Host-backed and MMIO memory paths. fetch_read returns 1 and fills value
+ * when the read is served from the log; is_playing tells the bridge to drop
+ * writes to host callbacks and devices. */
+int m68k_replay_fetch_read(unsigned int address, int size, unsigned int* value);
+void m68k_replay_log_read(unsigned int address, int size, unsigned int value);
+int m68k_replay_is_playing(void);
+
+/* ======================================================================== */
+/* ======================= TIME TRAVEL SUPPORT ============================ */
+/* ======================================================================== */
+/* Used by m68k_timetravel.cc to checkpoint and rewind a recording */
+
+/* Position of a recording within its log */
+typedef struct {
+    size_t offset;          /* Byte offset of the next event */
+    uint64_t position;      /* Instructions started */
+    uint64_t cycle;         /* Replay clock */
+    uint64_t last_position; /* Delta-encoding anchors */
+    uint64_t last_cycle;
+    uint64_t events;
+} m68k_replay_cursor;
+
+/* Called at every instruction boundary (after due events were applied) with
+ * the current position. Returning non-zero stops the execute loop before the
+ * instruction starts. */
+typedef int (*m68k_replay_boundary_hook_t)(uint64_t position);
+void m68k_replay_set_boundary_hook(m68k_replay_boundary_hook_t hook);
+
+/* Capture the recording cursor. Only valid while recording; returns -1 otherwise. */
+int m68k_replay_save_cursor(m68k_replay_cursor* cursor);
+
+/* Rewind the current log to a saved cursor and play it back. Once playback
+ * reaches live_position with the log exhausted, the engine switches back to
+ * recording and appends new inputs to the same log. */
+int m68k_replay_rewind(const m68k_replay_cursor* cursor, uint64_t live_position);
+
+/* Current replay clock (cycles since recording began) */
+uint64_t m68k_replay_cycle(void);
+
+/* Copy the events between two cursors of the current log into a standalone
+ * log ending with an END marker at `to`. Returns the required size; the data
+ * is written only when capacity is large enough. Returns 0 on bad cursors. */
+size_t m68k_replay_export_slice(const m68k_replay_cursor* from, const m68k_replay_cursor* to,
+                                uint8_t* out, size_t capacity);
+
+/* Play a log produced by m68k_replay_export_slice(), continuing the
+ * position, clock and delta anchors of the cursor it was cut at. */
+int m68k_replay_start_playback_at(const uint8_t* data, size_t size, const m68k_replay_cursor* start);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KREPLAY__HEADER */
@@ -0,0 +1,158 @@
+/* ======================================================================== */
+/* ===================== M68K STACK HIGH-WATER TRACKING ================== */
+/* ======================================================================== */
+
+#include "m68k_stackwatch.h"
+#include <cstdint>
+
+/* A zero-sized window sends the next instruction through the slow path */
+uint32_t m68k_stack_window_base = 0;
+uint32_t m68k_stack_window_size = 0;
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+struct m68k_stackwatch_state {
+    m68k_stack_region_t regions[M68K_STACK_MAX_REGIONS];
+    bool armed[M68K_STACK_MAX_REGIONS];     /* A7 is above the guard */
+    int count = 0;
+    int guard_hit = -1;
+};
+
+m68k_stackwatch_state g_sw;
+
+inline void invalidate_window() noexcept
+{
+    m68k_stack_window_base = 0;
+    m68k_stack_window_size = 0;
+}
+
+/* Outside every region: watch the gap between the neighbouring regions */
+void watch_gap(uint32_t sp) noexcept
+{
+    uint64_t gap_start = 0;
+    uint64_t gap_end = 0x100000000ULL;
+    for (int i = 0; i < g_sw.count; ++i) {
+        const m68k_stack_region_t& r = g_sw.regions[i];
+        if (r.end <= sp && r.end > gap_start) {
+            gap_start = r.end;
+        }
+        if (r.start > sp && r.start < gap_end) {
+            gap_end = r.start;
+        }
+    }
+    const uint64_t size = gap_end - gap_start;
+    m68k_stack_window_base = static_cast<uint32_t>(gap_start);
+    m68k_stack_window_size = size > 0xFFFFFFFFULL ? 0xFFFFFFFFu : static_cast<uint32_t>(size);
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_stack_add_region(uint32_t start, uint32_t end, uint32_t guard)
+{
+    if (start >= end || g_sw.count == M68K_STACK_MAX_REGIONS) {
+        return -1;
+    }
+    for (int i = 0; i < g_sw.count; ++i) {
+        const m68k_stack_region_t& r = g_sw.regions[i];
+        if (start < r.end && r.start < end) {
+            return -1;
+        }
+    }
+    m68k_stack_region_t& r = g_sw.regions[g_sw.count];
+    r.start = start;
+    r.end = end;
+    r.guard = (guard > start && guard < end) ? guard : 0;
+    r.low = end;
+    r.max_used = 0;
+    r.guard_hits = 0;
+    g_sw.armed[g_sw.count] = true;
+    invalidate_window();
+    return g_sw.count++;
+}
+
+void m68k_stack_clear_regions(void)
+{
+    g_sw.count = 0;
+    g_sw.guard_hit = -1;
+    invalidate_window();
+}
+
+void m68k_stack_reset_marks(void)
+{
+    for (int i = 0; i < g_sw.count; ++i) {
+        g_sw.regions[i].low = g_sw.regions[i].end;
+        g_sw.regions[i].max_used = 0;
+        g_sw.armed[i] = true;
+    }
+    g_sw.guard_hit = -1;
+    invalidate_window();
+}
+
+m68k_stack_region_t* m68k_stack_region_ptr(int handle)
+{
+    return (handle >= 0 && handle < g_sw.count) ? &g_sw.regions[handle] : nullptr;
+}
+
+int m68k_stack_take_guard_hit(void)
+{
+    const int hit = g_sw.guard_hit;
+    g_sw.guard_hit = -1;
+    return hit;
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+int m68k_stack_check(uint32_t sp)
+{
+    for (int i = 0; i < g_sw.count; ++i) {
+        m68k_stack_region_t& r = g_sw.regions[i];
+        if (sp < r.start || sp >= r.end) {
+            continue;
+        }
+        if (sp < r.low) {
+            r.low = sp;
+            r.max_used = r.end - sp;
+        }
+        if (r.guard == 0) {
+            m68k_stack_window_base = r.low;
+            m68k_stack_window_size = r.end - r.low;
+            return 0;
+        }
+        /* Guards fire once per crossing and re-arm once A7 is back above,
+         * so the window also ends at the guard on whichever side A7 is */
+        int tripped = 0;
+        bool& armed = g_sw.armed[i];
+        if (sp >= r.guard) {
+            armed = true;
+        } else if (armed) {
+            armed = false;
+            r.guard_hits++;
+            g_sw.guard_hit = i;
+            tripped = 1;
+        }
+        if (armed) {
+            m68k_stack_window_base = r.low > r.guard ? r.low : r.guard;
+            m68k_stack_window_size = r.end - m68k_stack_window_base;
+        } else {
+            m68k_stack_window_base = r.low;
+            m68k_stack_window_size = r.guard - r.low;
+        }
+        return tripped;
+    }
+    watch_gap(sp);
+    return 0;
+}
+
+} // extern "C"
@@ -0,0 +1,69 @@
+/* ======================================================================== */
+/* ===================== M68K STACK HIGH-WATER TRACKING ================== */
+/* ======================================================================== */
+
+#ifndef M68KSTACKWATCH__HEADER
+#define M68KSTACKWATCH__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define M68K_STACK_MAX_REGIONS 32
+
+/* Per-region usage (all fields uint32 for easy HEAPU32 access) */
+typedef struct m68k_stack_region {
+    uint32_t start;          /* Region is [start, end) */
+    uint32_t end;
+    uint32_t guard;          /* Stop when A7 goes below this (0 = no guard) */
+    uint32_t low;            /* Lowest A7 seen in the region (end if never entered) */
+    uint32_t max_used;       /* end - low */
+    uint32_t guard_hits;     /* Times A7 crossed below the guard */
+} m68k_stack_region_t;
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* A7 is checked after every instruction against a window cached from the
+ * region it is in: [lowest A7 seen so far, region end), split at the guard.
+ * Only leaving the window (a new low, crossing the guard either way or a
+ * switch to another stack) takes the slow path, so the steady-state cost is
+ * one compare per instruction. A guard fires each time A7 drops below it.
+ * Supervisor, user and per-task stacks are all just address ranges. */
+
+/* Returns a handle, or -1 if the range is empty, overlaps another region or
+ * the table is full. A guard outside (start, end) is ignored. */
+int m68k_stack_add_region(uint32_t start, uint32_t end, uint32_t guard);
+void m68k_stack_clear_regions(void);
+
+/* Forget high-water marks (and re-arm guards) for every region */
+void m68k_stack_reset_marks(void);
+
+/* Usage record for a handle, or NULL */
+m68k_stack_region_t* m68k_stack_region_ptr(int handle);
+
+/* Handle of the region whose guard ended the last timeslice, or -1;
+ * cleared by reading it */
+int m68k_stack_take_guard_hit(void);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from the CPU core - not part of public API */
+
+/* Current window; the core calls m68k_stack_check when
+ * (uint32_t)(A7 - base) >= size */
+extern uint32_t m68k_stack_window_base;
+extern uint32_t m68k_stack_window_size;
+
+/* Slow path: update marks and the window. Nonzero means a guard tripped. */
+int m68k_stack_check(uint32_t sp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KSTACKWATCH__HEADER */
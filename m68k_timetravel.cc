@@ -0,0 +1,785 @@
+/* ======================================================================== */
+/* ======================= M68K TIME TRAVEL DEBUGGING ===================== */
+/* ======================================================================== */
+
+#include "m68k_timetravel.h"
+#include "m68k_callstack.h"
+#include "m68k_dirty.h"
+#include "m68k_fetchcache.h"
+#include "m68k_replay.h"
+#include "m68k.h"
+#include "m68kcpu.h"
+#include "m68ktrace.h"
+#include "m68k_pagemap.h"
+#include "m68k_regions.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+/* ======================================================================== */
+/* ========================== INTERNAL STRUCTURES ======================== */
+/* ======================================================================== */
+
+namespace {
+
+constexpr uint64_t kNoLimit = ~0ULL;
+constexpr int kSeekTimeslice = 1'000'000;
+
+constexpr uint8_t kSegmentMagic[4] = {'M', '6', '8', 'S'};
+constexpr uint8_t kSegmentVersion = 3;
+
+/* Past either cap the checkpoint list is thinned (see thin_checkpoints) */
+constexpr size_t kMaxCheckpoints = 128;
+constexpr size_t kMaxCheckpointBytes = 128u << 20;
+
+constexpr uint32_t kNotBanked = ~0u;
+
+/* Banked regions keep their whole backing buffer and the window offset;
+ * other regions keep their own bytes */
+struct RegionSnapshot {
+    unsigned int start;
+    unsigned int size;
+    uint32_t bank_offset;
+    std::vector<uint8_t> bytes;
+};
+
+struct Checkpoint {
+    m68k_replay_cursor cursor;
+    std::vector<uint8_t> context;
+    std::vector<RegionSnapshot> regions;
+    std::vector<m68k_callstack_frame_t> frames;     /* Innermost first */
+};
+
+struct Watchpoint {
+    uint32_t start;
+    uint32_t size;
+};
+
+struct m68k_timetravel_state {
+    bool enabled = false;
+    uint32_t interval = 0;
+    std::vector<Checkpoint> checkpoints;
+    size_t checkpoint_bytes = 0;
+
+    /* Live end of history, refreshed whenever we leave it */
+    uint64_t present = 0;
+    uint64_t present_cycle = 0;
+
+    /* Forward re-execution control */
+    bool seeking = false;
+    bool stopped = false;
+    uint64_t stop_position = kNoLimit;
+    uint64_t stop_cycle = kNoLimit;
+
+    /* reverse_continue scan state */
+    bool scanning = false;
+    bool write_hit = false;
+    bool have_hit = false;
+    uint64_t scan_limit = 0;
+    uint64_t last_hit = 0;
+
+    std::unordered_set<uint32_t> breakpoints;
+    std::vector<Watchpoint> watchpoints;
+
+    /* Calls open at the start of a loaded segment, replayed to the tracer
+     * when it runs */
+    std::vector<m68k_callstack_frame_t> open_calls;
+};
+
+m68k_timetravel_state g_tt;
+
+size_t checkpoint_size(const Checkpoint& cp)
+{
+    size_t bytes = cp.context.size() + cp.frames.size() * sizeof(m68k_callstack_frame_t);
+    for (const RegionSnapshot& snap : cp.regions) {
+        bytes += snap.bytes.size();
+    }
+    return bytes;
+}
+
+/* Drop every other checkpoint after the first (keeping the newest) and
+ * double the interval, so history of any length fits the caps at the
+ * price of seeks re-executing further */
+void thin_checkpoints()
+{
+    std::vector<Checkpoint>& cps = g_tt.checkpoints;
+    const size_t newest = cps.size() - 1;
+    size_t kept = 1;
+    for (size_t k = 2; k <= newest; k += 2) {
+        cps[kept++] = std::move(cps[k]);
+    }
+    if (newest % 2 != 0) {
+        cps[kept++] = std::move(cps[newest]);
+    }
+    cps.resize(kept);
+
+    g_tt.checkpoint_bytes = 0;
+    for (const Checkpoint& cp : cps) {
+        g_tt.checkpoint_bytes += checkpoint_size(cp);
+    }
+    if (g_tt.interval <= UINT32_MAX / 2) {
+        g_tt.interval *= 2;
+    }
+}
+
+void take_checkpoint()
+{
+    Checkpoint cp;
+    if (m68k_replay_save_cursor(&cp.cursor) != 0) {
+        return;
+    }
+    cp.context.resize(m68k_context_size());
+    m68k_get_context(cp.context.data());
+    cp.frames.resize(M68K_CALLSTACK_MAX_DEPTH);
+    cp.frames.resize(m68k_get_backtrace_frames(cp.frames.data(), M68K_CALLSTACK_MAX_DEPTH));
+
+    const unsigned int count = get_region_count();
+    cp.regions.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        unsigned int start = 0;
+        unsigned int size = 0;
+        void* data = nullptr;
+        if (get_region_info(i, &start, &size, &data) != 0 || !data) {
+            continue;
+        }
+        /* Banks other than the mapped one may have been written earlier */
+        uint32_t bank_offset = kNotBanked;
+        unsigned int image_size = size;
+        get_region_bank(i, &data, &image_size, &bank_offset);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        cp.regions.push_back(RegionSnapshot{start, size, bank_offset,
+                                            std::vector<uint8_t>(bytes, bytes + image_size)});
+        if (get_region_swapped(i) == 1) {
+            /* Snapshots are always big-endian images */
+            m68k_pagemap::swap_words(cp.regions.back().bytes.data(), image_size);
+        }
+    }
+    g_tt.checkpoint_bytes += checkpoint_size(cp);
+    g_tt.checkpoints.push_back(std::move(cp));
+    while (g_tt.checkpoints.size() > 2 && (g_tt.checkpoints.size() > kMaxCheckpoints ||
+                                           g_tt.checkpoint_bytes > kMaxCheckpointBytes)) {
+        thin_checkpoints();
+    }
+}
+
+/* Restored bytes are dirty like any other write, mirrors included */
+void note_restored(uint32_t start, uint32_t size)
+{
+    if (!m68k_dirty_shift) {
+        return;
+    }
+    const uint64_t end = static_cast<uint64_t>(start) + size;
+    for (uint64_t a = start; a < end;) {
+        const uint64_t next = std::min<uint64_t>(end, (a | m68k_pagemap::kPageMask) + 1);
+        m68k_pagemap::note_dirty(static_cast<uint32_t>(a), static_cast<uint32_t>(next - a));
+        a = next;
+    }
+}
+
+/* Regions are matched by range (and backing size for banks); ones added
+ * after the snapshot keep their contents */
+void restore_regions(const std::vector<RegionSnapshot>& regions)
+{
+    const unsigned int count = get_region_count();
+    for (const RegionSnapshot& snap : regions) {
+        for (unsigned int i = 0; i < count; ++i) {
+            unsigned int start = 0;
+            unsigned int size = 0;
+            void* data = nullptr;
+            if (get_region_info(i, &start, &size, &data) != 0 || !data ||
+                start != snap.start || size != snap.size) {
+                continue;
+            }
+            unsigned int image_size = size;
+            uint32_t bank_offset = kNotBanked;
+            get_region_bank(i, &data, &image_size, &bank_offset);
+            if ((bank_offset == kNotBanked) != (snap.bank_offset == kNotBanked) ||
+                image_size != snap.bytes.size()) {
+                break;
+            }
+            std::memcpy(data, snap.bytes.data(), image_size);
+            if (get_region_swapped(i) == 1) {
+                m68k_pagemap::swap_words(static_cast<uint8_t*>(data), image_size);
+            }
+            if (snap.bank_offset != kNotBanked) {
+                remap_bank(get_region_handle(i), snap.bank_offset);
+            }
+            note_restored(start, size);
+            break;
+        }
+    }
+    /* Code may have changed under the cached fetch page */
+    m68k_fetch_cache_invalidate();
+}
+
+void restore_checkpoint(const Checkpoint& cp)
+{
+    m68k_set_context(const_cast<uint8_t*>(cp.context.data()));
+    restore_regions(cp.regions);
+    m68k_callstack_restore(cp.frames.data(), static_cast<int>(cp.frames.size()));
+    m68k_replay_rewind(&cp.cursor, g_tt.present);
+}
+
+/* Install a context captured by another instance. Host callbacks and cycle
+ * table pointers belong to this instance and are kept. The bytes sit at an
+ * arbitrary offset in the bundle, so they are copied into an aligned core
+ * before m68k_set_context reads them as one. */
+void adopt_foreign_context(const uint8_t* context)
+{
+    const m68ki_cpu_core local = m68ki_cpu;
+    m68ki_cpu_core foreign;
+    std::memcpy(&foreign, context, sizeof(foreign));
+    m68k_set_context(&foreign);
+    m68ki_cpu.cyc_instruction = local.cyc_instruction;
+    m68ki_cpu.cyc_exception = local.cyc_exception;
+    m68ki_cpu.int_ack_callback = local.int_ack_callback;
+    m68ki_cpu.bkpt_ack_callback = local.bkpt_ack_callback;
+    m68ki_cpu.reset_instr_callback = local.reset_instr_callback;
+    m68ki_cpu.cmpild_instr_callback = local.cmpild_instr_callback;
+    m68ki_cpu.rte_instr_callback = local.rte_instr_callback;
+    m68ki_cpu.tas_instr_callback = local.tas_instr_callback;
+    m68ki_cpu.illg_instr_callback = local.illg_instr_callback;
+    m68ki_cpu.pc_changed_callback = local.pc_changed_callback;
+    m68ki_cpu.set_fc_callback = local.set_fc_callback;
+    m68ki_cpu.instr_hook_callback = local.instr_hook_callback;
+}
+
+/* ======================================================================== */
+/* ========================== SEGMENT BUNDLES ============================ */
+/* ======================================================================== */
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void put_u64(std::vector<uint8_t>& out, uint64_t value)
+{
+    put_u32(out, static_cast<uint32_t>(value));
+    put_u32(out, static_cast<uint32_t>(value >> 32));
+}
+
+void put_bytes(std::vector<uint8_t>& out, const uint8_t* data, size_t size)
+{
+    put_u32(out, static_cast<uint32_t>(size));
+    out.insert(out.end(), data, data + size);
+}
+
+/* Calls on the shadow stack are opened (outermost first) and closed
+ * (innermost first) as flow events, so each segment's trace is balanced */
+void trace_open_calls(const std::vector<m68k_callstack_frame_t>& frames)
+{
+    for (size_t i = frames.size(); i-- > 0;) {
+        if (frames[i].kind == M68K_CALLSTACK_CALL) {
+            m68k_trace_flow_hook(M68K_TRACE_FLOW_CALL, frames[i].return_addr, frames[i].target,
+                                 frames[i].return_addr);
+        }
+    }
+}
+
+void trace_close_calls()
+{
+    m68k_callstack_frame_t frames[M68K_CALLSTACK_MAX_DEPTH];
+    const int count = m68k_get_backtrace_frames(frames, M68K_CALLSTACK_MAX_DEPTH);
+    const uint32_t pc = m68k_get_reg(nullptr, M68K_REG_PC);
+    for (int i = 0; i < count; ++i) {
+        if (frames[i].kind == M68K_CALLSTACK_CALL) {
+            m68k_trace_flow_hook(M68K_TRACE_FLOW_RETURN, pc, frames[i].return_addr, 0);
+        }
+    }
+}
+
+struct BundleReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+
+    const uint8_t* take(size_t n) {
+        if (!ok || size - pos < n) {
+            ok = false;
+            return nullptr;
+        }
+        const uint8_t* p = data + pos;
+        pos += n;
+        return p;
+    }
+    uint32_t u32() {
+        const uint8_t* p = take(4);
+        return p ? (p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24)) : 0;
+    }
+    uint64_t u64() {
+        const uint64_t lo = u32();
+        return lo | (static_cast<uint64_t>(u32()) << 32);
+    }
+};
+
+/* Latest checkpoint at or before a position (checkpoint 0 is the start) */
+const Checkpoint& checkpoint_for_position(uint64_t position)
+{
+    size_t k = g_tt.checkpoints.size() - 1;
+    while (k > 0 && g_tt.checkpoints[k].cursor.position > position) {
+        --k;
+    }
+    return g_tt.checkpoints[k];
+}
+
+const Checkpoint& checkpoint_for_cycle(uint64_t cycle)
+{
+    size_t k = g_tt.checkpoints.size() - 1;
+    while (k > 0 && g_tt.checkpoints[k].cursor.cycle > cycle) {
+        --k;
+    }
+    return g_tt.checkpoints[k];
+}
+
+/* Direct page writes only reach watchpoints through the page map observer */
+void update_write_observer()
+{
+    m68k_pagemap::g_write_observer =
+        (g_tt.enabled && !g_tt.watchpoints.empty()) ? m68k_timetravel_note_write : nullptr;
+}
+
+/* Remember where the live end of history is before moving into the past */
+void note_present()
+{
+    if (m68k_replay_get_mode() == M68K_REPLAY_RECORDING) {
+        g_tt.present = m68k_replay_position();
+        g_tt.present_cycle = m68k_replay_cycle();
+    }
+}
+
+bool limit_reached()
+{
+    return m68k_replay_position() >= g_tt.stop_position ||
+           m68k_replay_cycle() >= g_tt.stop_cycle;
+}
+
+/* Re-execute history until the stop position/cycle with host hooks suppressed */
+int run_forward(uint64_t stop_position, uint64_t stop_cycle)
+{
+    g_tt.stop_position = stop_position;
+    g_tt.stop_cycle = stop_cycle;
+    g_tt.stopped = limit_reached();
+    g_tt.seeking = true;
+
+    while (!g_tt.stopped) {
+        const uint64_t before = m68k_replay_position();
+        m68k_execute(kSeekTimeslice);
+        if (m68k_replay_diverged() ||
+            (!g_tt.stopped && m68k_replay_position() == before)) {
+            break;
+        }
+    }
+
+    const bool reached = g_tt.stopped;
+    g_tt.seeking = false;
+    g_tt.stopped = false;
+    g_tt.stop_position = kNoLimit;
+    g_tt.stop_cycle = kNoLimit;
+    return reached ? 0 : -1;
+}
+
+int boundary_hook(uint64_t position)
+{
+    if (g_tt.seeking) {
+        if (g_tt.scanning && position < g_tt.scan_limit) {
+            const uint32_t pc = m68k_get_reg(nullptr, M68K_REG_PC);
+            if (g_tt.write_hit || g_tt.breakpoints.count(pc) != 0) {
+                g_tt.have_hit = true;
+                g_tt.last_hit = position;
+            }
+        }
+        g_tt.write_hit = false;
+        if (limit_reached()) {
+            g_tt.stopped = true;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (m68k_replay_get_mode() == M68K_REPLAY_RECORDING && !g_tt.checkpoints.empty()) {
+        const m68k_replay_cursor& last = g_tt.checkpoints.back().cursor;
+        if (position > last.position && m68k_replay_cycle() - last.cycle >= g_tt.interval) {
+            take_checkpoint();
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+extern "C" {
+
+int m68k_timetravel_enable(uint32_t checkpoint_interval)
+{
+    if (checkpoint_interval == 0) {
+        return -1;
+    }
+    m68k_timetravel_disable();
+
+    g_tt.interval = checkpoint_interval;
+    m68k_replay_start_recording();
+    m68k_replay_set_boundary_hook(boundary_hook);
+    take_checkpoint();
+    g_tt.present = 0;
+    g_tt.present_cycle = 0;
+    g_tt.enabled = true;
+    update_write_observer();
+    return 0;
+}
+
+void m68k_timetravel_disable(void)
+{
+    if (!g_tt.enabled) {
+        return;
+    }
+    m68k_replay_set_boundary_hook(nullptr);
+    m68k_replay_stop();
+    g_tt.checkpoints.clear();
+    g_tt.checkpoint_bytes = 0;
+    g_tt.enabled = false;
+    g_tt.seeking = false;
+    g_tt.scanning = false;
+    update_write_observer();
+}
+
+int m68k_timetravel_is_enabled(void)
+{
+    return g_tt.enabled ? 1 : 0;
+}
+
+uint64_t m68k_timetravel_position(void)
+{
+    return m68k_replay_position();
+}
+
+uint64_t m68k_timetravel_present(void)
+{
+    if (!g_tt.enabled) {
+        return 0;
+    }
+    note_present();
+    return g_tt.present;
+}
+
+uint64_t m68k_timetravel_cycle(void)
+{
+    return m68k_replay_cycle();
+}
+
+unsigned int m68k_timetravel_checkpoint_count(void)
+{
+    return static_cast<unsigned int>(g_tt.checkpoints.size());
+}
+
+int m68k_timetravel_seek(uint64_t position)
+{
+    if (!g_tt.enabled) {
+        return -1;
+    }
+    note_present();
+    if (position > g_tt.present) {
+        return -1;
+    }
+
+    const uint64_t now = m68k_replay_position();
+    if (position == now) {
+        return 0;
+    }
+    const Checkpoint& cp = checkpoint_for_position(position);
+    if (!(now < position && now >= cp.cursor.position)) {
+        restore_checkpoint(cp);
+    }
+    return run_forward(position, kNoLimit);
+}
+
+int m68k_timetravel_seek_cycle(uint64_t cycle)
+{
+    if (!g_tt.enabled) {
+        return -1;
+    }
+    note_present();
+    if (cycle > g_tt.present_cycle) {
+        return -1;
+    }
+
+    const uint64_t now = m68k_replay_cycle();
+    const Checkpoint& cp = checkpoint_for_cycle(cycle);
+    if (!(now <= cycle && now >= cp.cursor.cycle)) {
+        restore_checkpoint(cp);
+    }
+    return run_forward(g_tt.present, cycle);
+}
+
+int m68k_timetravel_reverse_step(void)
+{
+    const uint64_t now = m68k_replay_position();
+    if (!g_tt.enabled || now == 0) {
+        return -1;
+    }
+    return m68k_timetravel_seek(now - 1);
+}
+
+int m68k_timetravel_reverse_continue(void)
+{
+    if (!g_tt.enabled) {
+        return -1;
+    }
+    note_present();
+
+    const uint64_t origin = m68k_replay_position();
+    uint64_t window_end = origin;
+    g_tt.scanning = true;
+    g_tt.scan_limit = origin;
+
+    /* Scan checkpoint windows newest first; the last hit in the first
+     * window that has one is the most recent. */
+    for (size_t k = g_tt.checkpoints.size(); k-- > 0 && window_end > 0;) {
+        const Checkpoint& cp = g_tt.checkpoints[k];
+        if (cp.cursor.position >= window_end) {
+            continue;
+        }
+        g_tt.have_hit = false;
+        g_tt.write_hit = false;
+        restore_checkpoint(cp);
+        if (run_forward(window_end, kNoLimit) != 0) {
+            g_tt.scanning = false;
+            return -1;
+        }
+        if (g_tt.have_hit) {
+            g_tt.scanning = false;
+            return m68k_timetravel_seek(g_tt.last_hit) == 0 ? 1 : -1;
+        }
+        window_end = cp.cursor.position;
+    }
+
+    g_tt.scanning = false;
+    return m68k_timetravel_seek(0) == 0 ? 0 : -1;
+}
+
+void m68k_timetravel_add_breakpoint(uint32_t pc)
+{
+    g_tt.breakpoints.insert(pc);
+}
+
+void m68k_timetravel_clear_breakpoints(void)
+{
+    g_tt.breakpoints.clear();
+}
+
+void m68k_timetravel_add_watchpoint(uint32_t address, uint32_t size)
+{
+    if (size > 0) {
+        g_tt.watchpoints.push_back(Watchpoint{address, size});
+        update_write_observer();
+    }
+}
+
+void m68k_timetravel_clear_watchpoints(void)
+{
+    g_tt.watchpoints.clear();
+    update_write_observer();
+}
+
+/* ======================================================================== */
+/* ========================== SEGMENT RE-TRACING ========================= */
+/* ======================================================================== */
+
+int m68k_timetravel_checkpoint(void)
+{
+    if (!g_tt.enabled || m68k_replay_get_mode() != M68K_REPLAY_RECORDING) {
+        return -1;
+    }
+    if (g_tt.checkpoints.back().cursor.position != m68k_replay_position()) {
+        take_checkpoint();
+    }
+    return 0;
+}
+
+unsigned int m68k_timetravel_segment_count(void)
+{
+    return g_tt.checkpoints.empty() ? 0 : static_cast<unsigned int>(g_tt.checkpoints.size() - 1);
+}
+
+int m68k_timetravel_export_segment(unsigned int index, uint8_t** data_out, size_t* size_out)
+{
+    if (!data_out || !size_out || index >= m68k_timetravel_segment_count()) {
+        return -1;
+    }
+    const Checkpoint& from = g_tt.checkpoints[index];
+    const Checkpoint& to = g_tt.checkpoints[index + 1];
+
+    const size_t log_size = m68k_replay_export_slice(&from.cursor, &to.cursor, nullptr, 0);
+    if (log_size == 0) {
+        return -1;
+    }
+    std::vector<uint8_t> log(log_size);
+    m68k_replay_export_slice(&from.cursor, &to.cursor, log.data(), log.size());
+
+    std::vector<uint8_t> out(kSegmentMagic, kSegmentMagic + sizeof(kSegmentMagic));
+    out.push_back(kSegmentVersion);
+    put_u64(out, from.cursor.position);
+    put_u64(out, from.cursor.cycle);
+    put_u64(out, from.cursor.last_position);
+    put_u64(out, from.cursor.last_cycle);
+    put_u64(out, from.cursor.events);
+    put_bytes(out, from.context.data(), from.context.size());
+    put_u32(out, static_cast<uint32_t>(from.frames.size()));
+    for (const m68k_callstack_frame_t& frame : from.frames) {
+        put_u32(out, frame.return_addr);
+        put_u32(out, frame.target);
+        put_u32(out, frame.sp);
+        put_u32(out, frame.cycle);
+        put_u32(out, frame.kind);
+        put_u32(out, frame.stack);
+    }
+    put_u32(out, static_cast<uint32_t>(from.regions.size()));
+    for (const RegionSnapshot& snap : from.regions) {
+        put_u32(out, snap.start);
+        put_u32(out, snap.size);
+        put_u32(out, snap.bank_offset);
+        put_bytes(out, snap.bytes.data(), snap.bytes.size());
+    }
+    put_bytes(out, log.data(), log.size());
+
+    uint8_t* buffer = static_cast<uint8_t*>(std::malloc(out.size()));
+    if (!buffer) {
+        return -1;
+    }
+    std::memcpy(buffer, out.data(), out.size());
+    *data_out = buffer;
+    *size_out = out.size();
+    return 0;
+}
+
+void m68k_timetravel_free_segment(uint8_t* data)
+{
+    std::free(data);
+}
+
+int m68k_timetravel_load_segment(const uint8_t* data, size_t size)
+{
+    if (!data) {
+        return -1;
+    }
+    BundleReader in{data, size};
+    const uint8_t* magic = in.take(sizeof(kSegmentMagic) + 1);
+    if (!magic || std::memcmp(magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 ||
+        magic[sizeof(kSegmentMagic)] != kSegmentVersion) {
+        return -1;
+    }
+
+    m68k_replay_cursor start{};
+    start.position = in.u64();
+    start.cycle = in.u64();
+    start.last_position = in.u64();
+    start.last_cycle = in.u64();
+    start.events = in.u64();
+
+    const uint32_t context_size = in.u32();
+    const uint8_t* context = in.take(context_size);
+    if (!context || context_size != m68k_context_size()) {
+        return -1;
+    }
+
+    const uint32_t frame_count = in.u32();
+    if (frame_count > M68K_CALLSTACK_MAX_DEPTH) {
+        return -1;
+    }
+    std::vector<m68k_callstack_frame_t> frames(frame_count);
+    for (m68k_callstack_frame_t& frame : frames) {
+        frame.return_addr = in.u32();
+        frame.target = in.u32();
+        frame.sp = in.u32();
+        frame.cycle = in.u32();
+        frame.kind = in.u32();
+        frame.stack = in.u32();
+    }
+
+    const uint32_t region_count = in.u32();
+    std::vector<RegionSnapshot> regions;
+    for (uint32_t i = 0; i < region_count && in.ok; ++i) {
+        const uint32_t region_start = in.u32();
+        const uint32_t region_size = in.u32();
+        const uint32_t bank_offset = in.u32();
+        const uint32_t image_size = in.u32();
+        const uint8_t* bytes = in.take(image_size);
+        if (bytes) {
+            regions.push_back(RegionSnapshot{region_start, region_size, bank_offset,
+                                             std::vector<uint8_t>(bytes, bytes + image_size)});
+        }
+    }
+
+    const uint32_t log_size = in.u32();
+    const uint8_t* log = in.take(log_size);
+    if (!in.ok) {
+        return -1;
+    }
+
+    m68k_timetravel_disable();
+    if (m68k_replay_start_playback_at(log, log_size, &start) != 0) {
+        return -1;
+    }
+    adopt_foreign_context(context);
+    restore_regions(regions);
+    m68k_callstack_restore(frames.data(), static_cast<int>(frames.size()));
+    g_tt.open_calls = std::move(frames);
+    m68k_set_total_cycles(start.cycle);
+    return 0;
+}
+
+int m68k_timetravel_run_segment(void)
+{
+    if (m68k_replay_get_mode() != M68K_REPLAY_PLAYING) {
+        return -1;
+    }
+    trace_open_calls(g_tt.open_calls);
+    g_tt.open_calls.clear();
+    while (!m68k_replay_finished() && !m68k_replay_diverged()) {
+        const uint64_t before = m68k_replay_position();
+        m68k_execute(kSeekTimeslice);
+        if (!m68k_replay_finished() && m68k_replay_position() == before) {
+            break;
+        }
+    }
+    trace_close_calls();
+    return m68k_replay_finished() && !m68k_replay_diverged() ? 0 : -1;
+}
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+
+int m68k_timetravel_seeking(void)
+{
+    return g_tt.seeking ? 1 : 0;
+}
+
+void m68k_timetravel_note_write(unsigned int address, int size)
+{
+    if (!g_tt.scanning) {
+        return;
+    }
+    const uint64_t begin = address;
+    const uint64_t end = begin + static_cast<uint64_t>(size);
+    for (const Watchpoint& wp : g_tt.watchpoints) {
+        const uint64_t wp_begin = wp.start;
+        const uint64_t wp_end = wp_begin + wp.size;
+        if (begin < wp_end && wp_begin < end) {
+            g_tt.write_hit = true;
+            return;
+        }
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,126 @@
+/* ======================================================================== */
+/* ======================= M68K TIME TRAVEL DEBUGGING ===================== */
+/* ======================================================================== */
+
+#ifndef M68KTIMETRAVEL__HEADER
+#define M68KTIMETRAVEL__HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ======================================================================== */
+/* ============================= PUBLIC API ============================== */
+/* ======================================================================== */
+
+/* Time travel combines the replay log (m68k_replay.h) with periodic
+ * checkpoints of the CPU context and all add_region() memory. Seeking
+ * restores the nearest earlier checkpoint and replays forward with
+ * instruction hooks suppressed, so seek latency is bounded by the
+ * checkpoint interval. Memory served by host callbacks or MMIO regions is
+ * not checkpointed; its reads come from the replay log and its writes are
+ * dropped while re-executing history.
+ *
+ * Positions are instruction counts since enabling; cycle values are the
+ * replay clock. Running forward from an earlier position replays history
+ * until the most recent position, then continues live. *
+ * Banked regions are checkpointed with their whole backing buffer and
+ * current bank, and a restore marks the restored memory dirty. Each
+ * checkpoint copies every region in full, so at most 128 are kept, using
+ * at most 128 MB together (the first and newest are always kept). Past
+ * either cap every other checkpoint is dropped and the interval doubles,
+ * so memory stays bounded on long runs at the cost of longer seeks. */
+
+/* Start recording history with a checkpoint every checkpoint_interval
+ * cycles. Returns 0 on success, -1 if the interval is 0. */
+int m68k_timetravel_enable(uint32_t checkpoint_interval);
+void m68k_timetravel_disable(void);
+int m68k_timetravel_is_enabled(void);
+
+/* Current and most recent (live) positions */
+uint64_t m68k_timetravel_position(void);
+uint64_t m68k_timetravel_present(void);
+uint64_t m68k_timetravel_cycle(void);
+unsigned int m68k_timetravel_checkpoint_count(void);
+
+/* Move to an instruction position, or to the first instruction boundary at
+ * or after a replay clock value. Returns 0 on success, -1 if the target
+ * lies outside the recorded history or replay diverged. */
+int m68k_timetravel_seek(uint64_t position);
+int m68k_timetravel_seek_cycle(uint64_t cycle);
+
+/* Undo the last executed instruction. Returns -1 at the start of history. */
+int m68k_timetravel_reverse_step(void);
+
+/* Run backwards to the most recent earlier position where a breakpoint PC
+ * was about to execute or a watchpoint was written (the position just after
+ * the writing instruction). Returns 1 when stopped on a hit, 0 when the
+ * start of history was reached, -1 on error. */
+int m68k_timetravel_reverse_continue(void);
+
+/* Breakpoints and write watchpoints used by reverse_continue */
+void m68k_timetravel_add_breakpoint(uint32_t pc);
+void m68k_timetravel_clear_breakpoints(void);
+void m68k_timetravel_add_watchpoint(uint32_t address, uint32_t size);
+void m68k_timetravel_clear_watchpoints(void);
+
+/* ======================================================================== */
+/* ========================== SEGMENT RE-TRACING ========================= */
+/* ======================================================================== */
+
+/* A segment is the stretch of history between two consecutive checkpoints.
+ * Long runs are recorded untraced, then each segment is exported as a
+ * self-contained bundle (CPU context, shadow call stack, region memory,
+ * replay log slice) and
+ * re-executed with tracing enabled in its own emulator instance (worker,
+ * process, WASM module). The core is a process-wide singleton, so segments
+ * run in parallel across instances, not threads. Loading a segment sets the
+ * trace cycle counter to the segment's start cycle, so the per-segment
+ * traces share one timeline and can be concatenated in order. */
+
+/* Take a checkpoint now, closing the current segment. Call outside
+ * m68k_execute() while live. Returns 0 on success, -1 otherwise. */
+int m68k_timetravel_checkpoint(void);
+
+/* Number of complete segments (checkpoints - 1). Thinning merges
+ * neighbouring segments, so export segments before the caps are reached
+ * if their boundaries matter. */
+unsigned int m68k_timetravel_segment_count(void);
+
+/* Serialize segment `index` into a malloc'd buffer freed with
+ * m68k_timetravel_free_segment(). Returns 0 on success, -1 otherwise. */
+int m68k_timetravel_export_segment(unsigned int index, uint8_t** data_out, size_t* size_out);
+void m68k_timetravel_free_segment(uint8_t* data);
+
+/* Load a segment bundle into this instance and start playing it back. The
+ * instance must be configured with the same CPU type and add_region()
+ * ranges; host callbacks are kept. Disables time travel. Returns 0 on
+ * success, -1 on a malformed bundle. */
+int m68k_timetravel_load_segment(const uint8_t* data, size_t size);
+
+/* Execute a loaded segment to its end with host hooks and tracing active.
+ * Calls open at the segment's start are traced as CALL flow events first,
+ * and calls still open at its end as RETURN events, so each segment's
+ * slices nest on their own and stitch across boundaries. Returns 0 when
+ * the segment completed, -1 on divergence. */
+int m68k_timetravel_run_segment(void);
+
+/* ======================================================================== */
+/* ==================== INTERNAL HOOK FUNCTIONS ========================== */
+/* ======================================================================== */
+/* These are called from myfunc.cc - not part of public API */
+
+/* Non-zero while history is being re-executed (host hooks are skipped) */
+int m68k_timetravel_seeking(void);
+
+/* Memory write notification for watchpoints */
+void m68k_timetravel_note_write(unsigned int address, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* M68KTIMETRAVEL__HEADER */
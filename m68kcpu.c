@@ -46,6 +46,9 @@ extern void (*m68ki_instruction_jump_table[0x10000])(void); /* opcode handler ju
 extern void m68ki_build_opcode_table(void);
 
 #include "m68ktrace.h"
+#include "m68k_replay.h"
+#include "m68k_fingerprint.h"
+#include "m68k_stackwatch.h"
 #include "m68kops.h"
 #include "m68kcpu.h"
 
@@ -76,6 +79,17 @@ static inline int opcode_is_jsr(uint16_t opcode)      { return (opcode & OPCODE_
 static inline int opcode_is_branch(uint16_t opcode)   { return (opcode & OPCODE_MASK_BRANCH_COND) == OPCODE_BASE_BRANCH_COND; }
 static inline int opcode_is_jmp(uint16_t opcode)      { return (opcode & OPCODE_MASK_JMP) == OPCODE_BASE_JMP; }
 
+/* Length of a Bcc/BRA/BSR instruction, i.e. where it falls through to */
+static inline uint32_t branch_length(uint16_t opcode)
+{
+	const uint32_t disp = opcode & 0xFF;
+	if (disp == 0)
+		return 4;
+	if (disp == 0xFF && CPU_TYPE_IS_EC020_PLUS(CPU_TYPE))
+		return 6;
+	return 2;
+}
+
 /* ======================================================================== */
 /* ================================= DATA ================================= */
 /* ======================================================================== */
@@ -750,6 +764,27 @@ void m68k_set_reg(m68k_register_t regnum, unsigned int value)
 	}
 }
 
+void m68k_get_all_regs(unsigned int* regs)
+{
+	int i;
+	for(i = 0; i < 16; i++)
+		regs[M68K_REG_D0 + i] = REG_DA[i];
+	regs[M68K_REG_PC] = MASK_OUT_ABOVE_32(REG_PC);
+	regs[M68K_REG_SR] = m68ki_get_sr();
+	regs[M68K_REG_SP] = REG_SP;
+	regs[M68K_REG_PPC] = REG_PPC;
+}
+
+void m68k_set_all_regs(const unsigned int* regs)
+{
+	int i;
+	for(i = 0; i < 16; i++)
+		REG_DA[i] = MASK_OUT_ABOVE_32(regs[M68K_REG_D0 + i]);
+	m68ki_set_sr_noint_nosp(regs[M68K_REG_SR]);
+	REG_PPC = MASK_OUT_ABOVE_32(regs[M68K_REG_PPC]);
+	m68ki_jump(MASK_OUT_ABOVE_32(regs[M68K_REG_PC]));
+}
+
 /* Set the callbacks */
 void m68k_set_int_ack_callback(int  (*callback)(int int_level))
 {
@@ -987,9 +1022,11 @@ int m68k_execute(int num_cycles)
 	/* Set our pool of clock cycles available */
 	SET_CYCLES(num_cycles);
 	m68ki_initial_cycles = num_cycles;
+	m68k_history_begin_slice();
 
-	/* See if interrupts came in */
-	m68ki_check_interrupts();
+	/* See if interrupts came in (replay playback defers this to the logged position) */
+	if (m68k_replay_execute_begin())
+		m68ki_check_interrupts();
 
 	/* Make sure we're not stopped */
 	if(!CPU_STOPPED)
@@ -1003,6 +1040,10 @@ int m68k_execute(int num_cycles)
 		do
 		{
 			int i;
+			/* Apply replayed inputs due before this instruction; stop at end of log */
+			if (m68k_replay_active && m68k_replay_instruction_boundary())
+				break;
+
 			/* Set tracing accodring to T1. (T0 is done inside instruction) */
 			m68ki_trace_t1(); /* auto-disable (see m68kcpu.h) */
 
@@ -1012,6 +1053,9 @@ int m68k_execute(int num_cycles)
 			/* Record previous program counter */
 			REG_PPC = REG_PC;
 
+			/* Interrupt handler entry is its first instruction starting */
+			m68k_irqlat_note_instruction(REG_PC);
+
 			/* Record previous D/A register state (in case of bus error) */
 			for (i = 15; i >= 0; i--){
 				REG_DA_SAVE[i] = REG_DA[i];
@@ -1032,6 +1076,9 @@ int m68k_execute(int num_cycles)
 			const uint32_t instr_start_pc = REG_PPC;
 			uint32_t pre_pc = REG_PC;
 			uint32_t post_pc;
+
+			if (m68k_history_pc_tracking)
+				m68k_history_note_pc(instr_start_pc);
 			
 			m68ki_instruction_jump_table[opcode]();
 			USE_CYCLES(executed_cycles);
@@ -1077,6 +1124,13 @@ int m68k_execute(int num_cycles)
 					is_flow_instruction = 1;
 				}
 				
+                    /* Last-branch record: taken transfers only */
+                    if (is_flow_instruction &&
+                        !(opcode_is_branch(opcode) && post_pc == instr_start_pc + branch_length(opcode))) {
+                        m68k_history_note_branch(instr_start_pc, post_pc, flow_type,
+                                                 m68ki_initial_cycles - GET_CYCLES());
+                    }
+
                     if (is_flow_instruction) {
                         const uint32_t return_addr = (flow_type == M68K_TRACE_FLOW_CALL) ? pre_pc : 0;
 
@@ -1103,9 +1157,15 @@ int m68k_execute(int num_cycles)
 
             /* THIS IS THE KEY FIX: Update the global trace cycle counter */
             m68k_trace_update_cycles(executed_cycles);
+            m68k_fingerprint_instruction(instr_start_pc, (uint16_t)opcode);
 
 			/* Trace m68k_exception, if necessary */
 			m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
+
+			/* Stack high-water: one compare unless A7 left its window */
+			if ((uint32_t)(REG_SP - m68k_stack_window_base) >= m68k_stack_window_size &&
+			    m68k_stack_check(REG_SP))
+				break;
 		} while(GET_CYCLES() > 0);
 
 		/* set previous PC to current PC for the next entry into the loop */
@@ -1115,7 +1175,12 @@ int m68k_execute(int num_cycles)
 		SET_CYCLES(0);
 
 	/* return how many clocks we used */
-	return m68ki_initial_cycles - GET_CYCLES();
+	{
+		int cycles_used = m68ki_initial_cycles - GET_CYCLES();
+		m68k_history_end_slice(cycles_used);
+		m68k_replay_execute_end(cycles_used);
+		return cycles_used;
+	}
 }
 
 
@@ -1136,6 +1201,12 @@ void m68k_modify_timeslice(int cycles)
 	ADD_CYCLES(cycles);
 }
 
+/* Charge cycles to the running timeslice, e.g. memory wait states */
+void m68k_use_cycles(int cycles)
+{
+	USE_CYCLES(cycles);
+}
+
 
 void m68k_end_timeslice(void)
 {
@@ -1150,8 +1221,15 @@ void m68k_end_timeslice(void)
  */
 void m68k_set_irq(unsigned int int_level)
 {
-	uint old_level = CPU_INT_LEVEL;
+	uint old_level;
+
+	/* Record the change, or ignore host changes while a replay log drives IRQs */
+	if (!m68k_replay_note_irq(int_level))
+		return;
+
+	old_level = CPU_INT_LEVEL;
 	CPU_INT_LEVEL = int_level << 8;
+	m68k_irqlat_note_level(old_level >> 8, int_level);
 
 	/* A transition from < 7 to 7 always interrupts (NMI) */
 	/* Note: Level 7 can also level trigger like a normal IRQ */
@@ -1215,8 +1293,16 @@ void m68k_pulse_bus_error(void)
 /* Pulse the RESET line on the CPU */
 void m68k_pulse_reset(void)
 {
+	/* Replay playback owns resets; host resets are ignored until it stops */
+	if (!m68k_replay_reset_begin())
+		return;
+
 	/* Disable the PMMU on reset */
 	m68ki_cpu.pmmu_enabled = 0;
+	m68k_fetch_cache_invalidate();
+
+	/* Nothing survives a reset on the guest stack */
+	m68k_callstack_clear();
 
 	/* Clear all stop levels and eat up all remaining cycles */
 	CPU_STOPPED = 0;
@@ -1252,6 +1338,8 @@ void m68k_pulse_reset(void)
 	CPU_RUN_MODE = RUN_MODE_NORMAL;
 
 	RESET_CYCLES = CYC_EXCEPTION[EXCEPTION_RESET];
+
+	m68k_replay_reset_end();
 }
 
 /* Pulse the HALT line on the CPU */
@@ -40,6 +40,9 @@ extern "C" {
 #include "m68k.h"
 #include "m68ktrace.h"
 #include "musashi_fault.h"
+#include "m68k_callstack.h"
+#include "m68k_irqlat.h"
+#include "m68k_fetchcache.h"
 
 #include <limits.h>
 
@@ -1074,7 +1077,11 @@ static inline uint m68ki_read_imm_16(void)
 }
 #else
 	REG_PC += 2;
+#if M68K_SEPARATE_READS
+	return m68k_fetch_16(ADDRESS_68K(REG_PC-2));
+#else
 	return m68k_read_immediate_16(ADDRESS_68K(REG_PC-2));
+#endif
 #endif /* M68K_EMULATE_PREFETCH */
 }
 
@@ -1123,7 +1130,11 @@ static inline uint m68ki_read_imm_32(void)
 	m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
 	m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM); /* auto-disable (see m68kcpu.h) */
 	REG_PC += 4;
+#if M68K_SEPARATE_READS
+	return m68k_fetch_32(ADDRESS_68K(REG_PC-4));
+#else
 	return m68k_read_immediate_32(ADDRESS_68K(REG_PC-4));
+#endif
 #endif /* M68K_EMULATE_PREFETCH */
 }
 
@@ -1242,6 +1253,104 @@ static inline void m68ki_write_32_pd_fc(uint address, uint fc, uint value)
 }
 #endif
 
+/* ------------------------- MOVEM block transfers ------------------------ */
+
+/* MOVEM moves the registers in mask (bit n = REG_DA[n]) to or from
+ * consecutive memory in ascending register order. When the memory system
+ * hands back the whole run as one span the registers are copied straight
+ * from host memory and these return 1; otherwise (other pages, PMMU,
+ * memory tracing so every access raises its event) they return 0 and the
+ * handler does its usual per-register accesses. size is 2 or 4;
+ * split_longs counts each long as the two word writes of the 32-bit
+ * predecrement slow path.
+ */
+static inline uint m68ki_movem_count(uint mask)
+{
+#if defined(__GNUC__)
+	return (uint)__builtin_popcount(mask);
+#else
+	uint count = 0;
+	for(; mask; mask &= mask - 1)
+		count++;
+	return count;
+#endif
+}
+
+static inline int m68ki_movem_load(uint address, uint mask, uint size)
+{
+	const unsigned char* p;
+	uint i;
+
+	if (PMMU_ENABLED || m68k_trace_is_enabled())
+		return 0;
+	p = m68k_movem_read_span(ADDRESS_68K(address), m68ki_movem_count(mask), size);
+	if (!p)
+		return 0;
+	m68ki_set_fc(FLAG_S | m68ki_get_address_space()); /* auto-disable (see m68kcpu.h) */
+	for(i = 0; i < 16; i++)
+		if(mask & (1 << i))
+		{
+			if (size == 2)
+			{
+				REG_DA[i] = MAKE_INT_16((p[0] << 8) | p[1]);
+				p += 2;
+			}
+			else
+			{
+				REG_DA[i] = ((uint)p[0] << 24) | ((uint)p[1] << 16) | ((uint)p[2] << 8) | p[3];
+				p += 4;
+			}
+		}
+	return 1;
+}
+
+static inline int m68ki_movem_store(uint address, uint mask, uint size, int split_longs)
+{
+	unsigned char* p;
+	uint count;
+	uint i;
+
+	if (PMMU_ENABLED || m68k_trace_is_enabled())
+		return 0;
+	count = m68ki_movem_count(mask);
+	p = split_longs ? m68k_movem_write_span(ADDRESS_68K(address), count * 2, 2)
+	                : m68k_movem_write_span(ADDRESS_68K(address), count, size);
+	if (!p)
+		return 0;
+	m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_DATA); /* auto-disable (see m68kcpu.h) */
+	for(i = 0; i < 16; i++)
+		if(mask & (1 << i))
+		{
+			const uint value = REG_DA[i];
+			if (size == 2)
+			{
+				p[0] = (value >> 8) & 0xff;
+				p[1] = value & 0xff;
+				p += 2;
+			}
+			else
+			{
+				p[0] = value >> 24;
+				p[1] = (value >> 16) & 0xff;
+				p[2] = (value >> 8) & 0xff;
+				p[3] = value & 0xff;
+				p += 4;
+			}
+		}
+	return 1;
+}
+
+/* Predecrement lists are reversed: bit n stands for REG_DA[15 - n] */
+static inline uint m68ki_movem_pd_mask(uint register_list)
+{
+	uint mask = 0;
+	uint i;
+	for(i = 0; i < 16; i++)
+		if(register_list & (1 << i))
+			mask |= 1 << (15 - i);
+	return mask;
+}
+
 /* --------------------- Effective Address Calculation -------------------- */
 
 /* The program counter relative addressing modes cause operands to be
@@ -1497,6 +1606,8 @@ static inline void m68ki_jump_vector(uint vector)
 	 * CRITICAL: Don't overwrite PC before reading! */
 	uint32_t vector_addr = (vector<<2) + REG_VBR;
 	uint32_t new_pc = m68ki_read_data_32(vector_addr);
+	/* The frame is stacked by now: record it in the shadow call stack */
+	m68k_callstack_exception(REG_PC, new_pc);
 	/* Now jump to the vector handler */
 	m68ki_jump(new_pc);
 }
@@ -1528,24 +1639,29 @@ static inline void m68ki_branch_32(uint offset)
 /* Trace-aware BSR (Branch to Subroutine) */
 static inline void m68ki_trace_bsr(uint source_pc, uint dest_pc, uint return_addr)
 {
+	m68k_callstack_call(return_addr, dest_pc);
 	m68k_trace_flow_hook(M68K_TRACE_FLOW_CALL, source_pc, dest_pc, return_addr);
 }
 
 /* Trace-aware JSR (Jump to Subroutine) */
 static inline void m68ki_trace_jsr(uint source_pc, uint dest_pc, uint return_addr)
 {
+	m68k_callstack_call(return_addr, dest_pc);
 	m68k_trace_flow_hook(M68K_TRACE_FLOW_CALL, source_pc, dest_pc, return_addr);
 }
 
 /* Trace-aware RTS (Return from Subroutine) */
 static inline void m68ki_trace_rts(uint source_pc, uint dest_pc)
 {
+	m68k_callstack_return();
 	m68k_trace_flow_hook(M68K_TRACE_FLOW_RETURN, source_pc, dest_pc, 0);
 }
 
 /* Trace-aware RTE (Return from Exception) */
 static inline void m68ki_trace_rte(uint source_pc, uint dest_pc)
 {
+	m68k_callstack_return();
+	m68k_irqlat_note_rte();
 	m68k_trace_flow_hook(M68K_TRACE_FLOW_EXCEPTION_RETURN, source_pc, dest_pc, 0);
 }
 
@@ -2257,6 +2373,8 @@ static inline void m68ki_exception_interrupt(uint int_level)
 		m68ki_stack_frame_0001(REG_PC, sr, vector);
 	}
 
+	m68k_callstack_exception(REG_PC, new_pc);
+	m68k_irqlat_note_ack(int_level, vector, new_pc);
 	m68ki_jump(new_pc);
 
 	/* Defer cycle counting until later */
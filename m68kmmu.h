@@ -291,6 +291,7 @@ void m68881_mmu_ops(void)
 										fprintf(stderr,"680x0: PMOVE to unknown MMU register %x, PC %x\n", (modes>>10) & 7, REG_PC);
 										break;
 								}
+								m68k_fetch_cache_invalidate();
 							}
 							break;
 
@@ -5,6 +5,7 @@
 #include "m68ktrace.h"
 #include "m68k.h"
 #include "m68kcpu.h"
+#include "m68k_hookcost.h"
 #include <cstring>
 #include <cstdint>
 #include <climits>
@@ -164,6 +165,11 @@ void m68k_reset_total_cycles(void)
     g_trace.total_cycles = 0;
 }
 
+void m68k_set_total_cycles(uint64_t cycles)
+{
+    g_trace.total_cycles = cycles;
+}
+
 /* ======================================================================== */
 /* ==================== INTERNAL HOOK FUNCTIONS ========================== */
 /* ======================================================================== */
@@ -178,6 +184,7 @@ int m68k_trace_instruction_hook(unsigned int pc, uint16_t opcode, int cycles_exe
     /* Check all conditions before calling callback */
     if (should_invoke_trace(g_trace.instr_enabled, g_trace.instr_callback)) {
         /* Call callback with protection against exceptions */
+        m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_TRACE_INSTR, pc);
         result = g_trace.instr_callback(pc, opcode, g_trace.total_cycles, cycles_executed);
 
         /* Sanitize return value */
@@ -210,6 +217,7 @@ int m68k_trace_flow_hook(m68k_trace_flow_type type, uint32_t source_pc,
         }
 
         /* Call callback with protection */
+        m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_TRACE_FLOW, source_pc);
         result = g_trace.flow_callback(type, source_pc, dest_pc, return_addr,
                                        d_regs.data(), a_regs.data(), g_trace.total_cycles);
 
@@ -238,6 +246,7 @@ int m68k_trace_mem_hook(m68k_trace_mem_type type, uint32_t pc,
     if (should_invoke_trace(g_trace.mem_enabled, g_trace.mem_callback)) {
         if (is_address_traced(address)) {
             /* Call callback with protection */
+            m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_TRACE_MEM, pc);
             result = g_trace.mem_callback(type, pc, address, value, size,
                                           g_trace.total_cycles);
 
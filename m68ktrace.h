@@ -143,6 +143,9 @@ uint64_t m68k_get_total_cycles(void);
 /* Reset cycle counter */
 void m68k_reset_total_cycles(void);
 
+/* Set cycle counter (aligns traces of replayed segments with the original run) */
+void m68k_set_total_cycles(uint64_t cycles);
+
 /* ======================================================================== */
 /* ==================== INTERNAL HOOK FUNCTIONS ========================== */
 /* ======================================================================== */
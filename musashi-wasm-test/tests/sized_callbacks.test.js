@@ -0,0 +1,54 @@
+import createMusashiModule from '../load-musashi.js';
+
+describe('Sized JS memory callbacks', () => {
+  test('long and word accesses prefer sized callbacks over byte composition', async () => {
+    const mod = await createMusashiModule();
+    const memSize = 1 << 20;
+    const mem = new Uint8Array(memSize);
+    const view = new DataView(mem.buffer);
+    const resetPC = 0x400;
+    // move.l $2000.w,d0 ; move.w d0,$3000.w ; move.l d0,$3004.w
+    mem.set([0x20, 0x38, 0x20, 0x00, 0x31, 0xc0, 0x30, 0x00, 0x21, 0xc0, 0x30, 0x04], resetPC);
+    view.setUint32(0x2000, 0x11223344);
+
+    const calls = { read8: 0, read16: 0, read32: 0, write8: 0, write16: 0, write32: 0 };
+    const mask = (addr) => addr & (memSize - 1);
+    const fns = [
+      mod.addFunction((addr) => { calls.read8++; return mem[mask(addr)]; }, 'ii'),
+      mod.addFunction((addr, val) => { calls.write8++; mem[mask(addr)] = val & 0xff; }, 'vii'),
+      mod.addFunction((addr) => { calls.read16++; return view.getUint16(mask(addr)); }, 'ii'),
+      mod.addFunction((addr) => { calls.read32++; return view.getUint32(mask(addr)); }, 'ii'),
+      mod.addFunction((addr, val) => { calls.write16++; view.setUint16(mask(addr), val); }, 'vii'),
+      mod.addFunction((addr, val) => { calls.write32++; view.setUint32(mask(addr), val >>> 0); }, 'vii'),
+    ];
+
+    try {
+      mod._set_read8_callback(fns[0]);
+      mod._set_write8_callback(fns[1]);
+      mod._set_read16_callback(fns[2]);
+      mod._set_read32_callback(fns[3]);
+      mod._set_write16_callback(fns[4]);
+      mod._set_write32_callback(fns[5]);
+
+      mod._m68k_init();
+      mod._set_entry_point(resetPC);
+      mod._m68k_step_one();
+      mod._m68k_step_one();
+      mod._m68k_step_one();
+
+      expect(view.getUint16(0x3000)).toBe(0x3344);
+      expect(view.getUint32(0x3004)).toBe(0x11223344);
+      expect(calls.read32).toBeGreaterThan(0);
+      expect(calls.write16).toBe(1);
+      expect(calls.write32).toBe(1);
+      expect(calls.read8).toBe(0);
+      expect(calls.write8).toBe(0);
+    } finally {
+      mod._set_read16_callback(0);
+      mod._set_read32_callback(0);
+      mod._set_write16_callback(0);
+      mod._set_write32_callback(0);
+      fns.forEach((fn) => mod.removeFunction(fn));
+    }
+  }, 20000);
+});
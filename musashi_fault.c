@@ -2,9 +2,35 @@
 #include "m68kcpu.h"
 
 static musashi_fault_record_t g_fault_record;
+static musashi_history_t g_history = { .size = MUSASHI_HISTORY_SIZE };
+static uint64_t g_history_cycle_base;
+static int g_history_in_slice;
+
+/* Guest access the bridge saw fail, reported by the next bus error */
+typedef struct musashi_bus_access {
+  int active;
+  uint32_t address;
+  uint32_t size;
+  int write;
+} musashi_bus_access_t;
+static musashi_bus_access_t g_bus_access;
+
+uint32_t m68k_history_pc_tracking;
 
 void m68k_fault_clear(void) {
   g_fault_record.active = 0;
+  g_bus_access.active = 0;
+}
+
+void m68k_fault_note_bus_access(uint32_t address, uint32_t size, int write) {
+  g_bus_access.active = 1;
+  g_bus_access.address = address;
+  g_bus_access.size = size;
+  g_bus_access.write = write ? 1 : 0;
+}
+
+int m68k_fault_writing_frame(void) {
+  return CPU_RUN_MODE == RUN_MODE_BERR_AERR_RESET_WSF;
 }
 
 musashi_fault_record_t* m68k_fault_record_ptr(void) {
@@ -16,6 +42,12 @@ void m68k_fault_capture(musashi_fault_kind_t kind,
                         uint32_t address,
                         uint32_t size,
                         uint32_t extra) {
+  if (kind == MUSASHI_FAULT_KIND_BUS_ERROR && g_bus_access.active) {
+    address = g_bus_access.address;
+    size = g_bus_access.size;
+    extra = (uint32_t)g_bus_access.write;
+    g_bus_access.active = 0;
+  }
   g_fault_record.active = 1;
   g_fault_record.kind = (uint32_t)kind;
   g_fault_record.vector = vector;
@@ -27,4 +59,55 @@ void m68k_fault_capture(musashi_fault_kind_t kind,
   g_fault_record.sr = m68k_get_reg(NULL, M68K_REG_SR);
   g_fault_record.opcode = m68k_get_reg(NULL, M68K_REG_IR);
   g_fault_record.extra = extra;
+  g_fault_record.branch_seq = g_history.branch_count;
+}
+
+musashi_history_t* m68k_history_ptr(void) {
+  return &g_history;
+}
+
+void m68k_history_clear(void) {
+  g_history.branch_count = 0;
+  g_history.pc_count = 0;
+  g_history_cycle_base = 0;
+}
+
+void m68k_history_set_pc_tracking(int enable) {
+  g_history.pc_enabled = enable ? 1 : 0;
+  m68k_history_pc_tracking = g_history.pc_enabled;
+}
+
+void m68k_history_note_branch(uint32_t from, uint32_t to, uint32_t kind, int slice_cycles) {
+  musashi_branch_record_t* rec =
+      &g_history.branches[g_history.branch_count++ % MUSASHI_HISTORY_SIZE];
+  rec->from = from;
+  rec->to = to;
+  rec->cycles = (uint32_t)(g_history_cycle_base + (uint64_t)slice_cycles);
+  rec->kind = kind;
+}
+
+void m68k_history_note_pc(uint32_t pc) {
+  g_history.pcs[g_history.pc_count++ % MUSASHI_HISTORY_SIZE] = pc;
+}
+
+uint64_t m68k_history_clock(void) {
+  if (!g_history_in_slice) {
+    return g_history_cycle_base;
+  }
+  return g_history_cycle_base + (uint64_t)m68k_cycles_run();
+}
+
+void m68k_history_begin_slice(void) {
+  g_history_in_slice = 1;
+}
+
+int m68k_history_in_slice(void) {
+  return g_history_in_slice;
+}
+
+void m68k_history_end_slice(int slice_cycles) {
+  g_history_in_slice = 0;
+  if (slice_cycles > 0) {
+    g_history_cycle_base += (uint64_t)slice_cycles;
+  }
 }
@@ -29,8 +29,31 @@ typedef struct musashi_fault_record {
   uint32_t sr;
   uint32_t opcode;
   uint32_t extra;
+  uint32_t branch_seq;  /* history.branch_count when the fault was captured */
 } musashi_fault_record_t;
 
+/* Last-branch record: an always-on ring of the most recent taken control
+ * flow transfers (BSR/JSR, RTS/RTR/RTD, BRA/Bcc, JMP), plus an optional ring
+ * of the most recent instruction PCs. Entry i of a ring lives at index
+ * i % MUSASHI_HISTORY_SIZE; the newest is at (count - 1). */
+#define MUSASHI_HISTORY_SIZE 64
+
+typedef struct musashi_branch_record {
+  uint32_t from;    /* PC of the branch instruction */
+  uint32_t to;      /* PC after it executed */
+  uint32_t cycles;  /* Low 32 bits of the history cycle clock */
+  uint32_t kind;    /* m68k_trace_flow_type */
+} musashi_branch_record_t;
+
+typedef struct musashi_history {
+  uint32_t branch_count;  /* Branches recorded since the last clear */
+  uint32_t pc_count;      /* PCs recorded since the last clear */
+  uint32_t pc_enabled;
+  uint32_t size;          /* MUSASHI_HISTORY_SIZE */
+  musashi_branch_record_t branches[MUSASHI_HISTORY_SIZE];
+  uint32_t pcs[MUSASHI_HISTORY_SIZE];
+} musashi_history_t;
+
 void m68k_fault_clear(void);
 musashi_fault_record_t* m68k_fault_record_ptr(void);
 void m68k_fault_capture(musashi_fault_kind_t kind,
@@ -39,6 +62,28 @@ void m68k_fault_capture(musashi_fault_kind_t kind,
                         uint32_t size,
                         uint32_t extra);
 
+musashi_history_t* m68k_history_ptr(void);
+void m68k_history_clear(void);
+void m68k_history_set_pc_tracking(int enable);
+
+/* Called from the memory bridge - not part of public API. The next bus
+ * error captured reports this access (extra is 1 for a write) instead of
+ * the PPC; m68k_fault_clear drops it. */
+void m68k_fault_note_bus_access(uint32_t address, uint32_t size, int write);
+/* Non-zero while a bus or address error is writing its stack frame */
+int m68k_fault_writing_frame(void);
+
+/* Called from m68k_execute - not part of public API */
+extern uint32_t m68k_history_pc_tracking;
+void m68k_history_note_branch(uint32_t from, uint32_t to, uint32_t kind, int slice_cycles);
+void m68k_history_note_pc(uint32_t pc);
+void m68k_history_begin_slice(void);
+void m68k_history_end_slice(int slice_cycles);
+/* Non-zero while m68k_execute is running a timeslice */
+int m68k_history_in_slice(void);
+/* Cycles executed since the last clear, including the running timeslice */
+uint64_t m68k_history_clock(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,8 +3,22 @@
 #include "m68ktrace.h"
 #include "m68k_perfetto.h"
 #include "musashi_fault.h"
-
+#include "m68k_replay.h"
+#include "m68k_timetravel.h"
+#include "m68k_memo.h"
+#include "m68k_fingerprint.h"
+#include "m68k_callstack.h"
+#include "m68k_stackwatch.h"
+#include "m68k_irqlat.h"
+#include "m68k_hookcost.h"
+#include "m68k_bridgestats.h"
+#include "m68k_dirty.h"
+#include "m68k_pagemap.h"
+#include "m68k_regions.h"
+
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <unordered_set>
 #include <unordered_map>
 #include <optional>
@@ -94,13 +108,13 @@ class SentinelSession {
   bool saved_value_valid = false;
 
  private:
-  static inline unsigned int mask24(unsigned int value) {
-    return value & kAddr24Mask;
+  static inline unsigned int mask_sp(unsigned int value) {
+    return value & m68k_pagemap::g_address_mask;
   }
 
   void install_sentinel() {
     // Capture current SP so we can restore it accurately when the session ends.
-    saved_sp = mask24(m68k_get_reg(nullptr, M68K_REG_SP));
+    saved_sp = mask_sp(m68k_get_reg(nullptr, M68K_REG_SP));
     sentinel_consumed = false;
     sentinel_installed = false;
     saved_value_valid = true;
@@ -126,7 +140,7 @@ class SessionGuard {
 };
 
 enum class HookResult : int { Continue = 0, Break = 1 };
-enum class BreakReason : int { None = 0, Trace = 1, InstrHook = 2, JsHook = 3, Sentinel = 4, Step = 5 };
+enum class BreakReason : int { None = 0, Trace = 1, InstrHook = 2, JsHook = 3, Sentinel = 4, Step = 5, Unmapped = 6 };
 static BreakReason _last_break_reason = BreakReason::None;
 
 static inline HookResult finalize_break_request(BreakReason reason, bool allow_break) {
@@ -178,7 +192,11 @@ static inline HookResult processHooks(const HookContext& ctx, bool allow_break)
 
   // Full instruction hook
   if (_instr_hook) {
-    int result = _instr_hook(ctx.pc, ctx.ir, ctx.cycles);
+    int result;
+    {
+      m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_INSTR_HOOK, ctx.pc);
+      result = _instr_hook(ctx.pc, ctx.ir, ctx.cycles);
+    }
     if (result != 0) {
       return finalize_break_request(BreakReason::InstrHook, allow_break);
     }
@@ -207,6 +225,7 @@ static inline HookResult processHooks(const HookContext& ctx, bool allow_break)
     if (_enable_printf_logging) {
       printf("processHooks: sentinel pc encountered (pc=0x%08X)\n", ctx.pc);
     }
+    m68k_memo_returned();
     if (allow_break) {
       m68k_end_timeslice();
     }
@@ -223,47 +242,85 @@ static inline HookResult processHooks(const HookContext& ctx, bool allow_break)
 // JavaScript callback function pointers
 typedef uint8_t (*read8_callback_t)(uint32_t addr);
 typedef void (*write8_callback_t)(uint32_t addr, uint8_t val);
+typedef uint32_t (*read_sized_callback_t)(uint32_t addr);
+typedef void (*write_sized_callback_t)(uint32_t addr, uint32_t val);
 typedef int (*probe_callback_t)(uint32_t addr);
 
 static read8_callback_t js_read8_callback = nullptr;
 static write8_callback_t js_write8_callback = nullptr;
+// Optional sized callbacks; each access size uses one when set and falls
+// back to composing smaller accesses otherwise
+static read_sized_callback_t js_read16_callback = nullptr;
+static read_sized_callback_t js_read32_callback = nullptr;
+static write_sized_callback_t js_write16_callback = nullptr;
+static write_sized_callback_t js_write32_callback = nullptr;
 static probe_callback_t js_probe_callback = nullptr;
 
-// 24-bit address masking for 68000 (16MB address space)
-static inline uint32_t addr24(uint32_t addr) {
-    return addr & 0x00FFFFFFu;
+// Guest address masking: 24 bits (68000, the default) or 32 bits
+static inline uint32_t mask_address(uint32_t addr) {
+    return addr & m68k_pagemap::g_address_mask;
 }
 
 // Big-endian composition functions with address masking
 static uint16_t read16_be(uint32_t addr) {
+    addr = mask_address(addr);
+    if (js_read16_callback) return js_read16_callback(addr) & 0xFFFF;
     if (!js_read8_callback) return 0;
-    addr = addr24(addr);
-    return (js_read8_callback(addr) << 8) | js_read8_callback(addr24(addr + 1));
+    return (js_read8_callback(addr) << 8) | js_read8_callback(mask_address(addr + 1));
 }
 
 static uint32_t read32_be(uint32_t addr) {
+    if (js_read32_callback) return js_read32_callback(mask_address(addr));
     return ((uint32_t)read16_be(addr) << 16) | read16_be(addr + 2);
 }
 
 static void write16_be(uint32_t addr, uint16_t val) {
+    addr = mask_address(addr);
+    if (js_write16_callback) {
+        js_write16_callback(addr, val);
+        return;
+    }
     if (!js_write8_callback) return;
-    addr = addr24(addr);
     js_write8_callback(addr, (val >> 8) & 0xFF);
-    js_write8_callback(addr24(addr + 1), val & 0xFF);
+    js_write8_callback(mask_address(addr + 1), val & 0xFF);
 }
 
 static void write32_be(uint32_t addr, uint32_t val) {
+    if (js_write32_callback) {
+        js_write32_callback(mask_address(addr), val);
+        return;
+    }
     write16_be(addr, (val >> 16) & 0xFFFF);
     write16_be(addr + 2, val & 0xFFFF);
 }
 
+extern "C" unsigned int my_read_memory(unsigned int address, int size);
+extern "C" void my_write_memory(unsigned int address, int size, unsigned int value);
+
+// Bounds mirror-to-mirror chains (see resolve_region)
+static constexpr int kMaxMirrorDepth = 8;
+
 struct Region {
+  int handle_;
+  m68k_region_kind kind_;
   unsigned int start_;
   unsigned int size_;
-  uint8_t* data_;
-
-  Region(unsigned int start, unsigned int size, void* data)
-    : start_(start), size_(size), data_(static_cast<uint8_t*>(data))
+  uint8_t* data_;         // RAM / ROM backing, null otherwise
+  uint8_t* bank_base_;    // Banked regions: whole backing buffer, null otherwise
+  unsigned int bank_size_;
+  uint32_t flags_;        // m68k_pagemap::kPage* storage flags
+  int rom_write_policy_;  // M68K_ROM_WRITE_*
+  uint32_t wait_;         // Wait cycles per bus cycle
+  unsigned int target_;   // Mirror target
+  m68k_mmio_handlers_t mmio_;
+  void* context_;
+
+  Region(int handle, m68k_region_kind kind, unsigned int start, unsigned int size, void* data,
+         uint32_t flags = 0)
+    : handle_(handle), kind_(kind), start_(start), size_(size),
+      data_(static_cast<uint8_t*>(data)), bank_base_(nullptr), bank_size_(0), flags_(flags),
+      rom_write_policy_(M68K_ROM_WRITE_IGNORE), wait_(0),
+      target_(0), mmio_{}, context_(nullptr)
   {}
   // Note: Region does not own the memory, caller is responsible for cleanup
 
@@ -271,26 +328,43 @@ struct Region {
     if (!contains(addr, size)) {
       return std::nullopt;
     }
-    unsigned int offset = addr - start_;
-    unsigned int value = 0;
-    for (int i = 0; i < size; ++i) {
-      value = (value << 8) | data_[offset + i];
+    const uint32_t offset = addr - start_;
+    switch (size) {
+      case 1: return load<1>(offset);
+      case 2: return load<2>(offset);
+      case 4: return load<4>(offset);
+      default: return std::nullopt;
     }
-    return value;
   }
 
   bool write(unsigned int addr, int size, unsigned int value) {
     if (!contains(addr, size)) {
       return false;
     }
-    unsigned int offset = addr - start_;
-    for (int i = 0; i < size; ++i) {
-      data_[offset + i] = (value >> ((size - 1 - i) * 8)) & 0xFF;
+    const uint32_t offset = addr - start_;
+    switch (kind_) {
+      case M68K_REGION_ROM:
+        if (rom_write_policy_ == M68K_ROM_WRITE_FAULT && m68k_history_in_slice()) {
+          m68k_fault_note_bus_access(addr, static_cast<uint32_t>(size), 1);
+          m68k_pulse_bus_error();
+        }
+        return true;
+      default:
+        break;
+    }
+    switch (size) {
+      case 1: store<1>(offset, value); return true;
+      case 2: store<2>(offset, value); return true;
+      case 4: store<4>(offset, value); return true;
+      default: return false;
     }
-    return true;
   }
 
- private:
+  // Address a mirror access at addr lands on
+  uint32_t mirror_target(unsigned int addr) const {
+    return mask_address(target_ + (addr - start_));
+  }
+
   bool contains(unsigned int addr, int size) const {
     if (size <= 0) {
       return false;
@@ -304,8 +378,199 @@ struct Region {
 
     return request_start >= region_start && request_end <= region_end;
   }
+
+  // Bridge statistics class for a hit in this region
+  m68k_bridge_path path() const {
+    return kind_ == M68K_REGION_MMIO ? M68K_BRIDGE_PATH_MMIO : M68K_BRIDGE_PATH_REGION;
+  }
+
+ private:
+  template <unsigned int Size>
+  unsigned int load(uint32_t offset) const {
+    if (kind_ == M68K_REGION_MMIO) {
+      return mmio_read(offset, Size);
+    }
+    return (flags_ & m68k_pagemap::kPageSwapped)
+        ? m68k_pagemap::load_swapped<Size>(data_, offset)
+        : m68k_pagemap::load_be<Size>(data_ + offset);
+  }
+
+  template <unsigned int Size>
+  void store(uint32_t offset, unsigned int value) {
+    if (kind_ == M68K_REGION_MMIO) {
+      mmio_write(offset, Size, value);
+    } else if (flags_ & m68k_pagemap::kPageSwapped) {
+      m68k_pagemap::store_swapped<Size>(data_, offset, value);
+    } else {
+      m68k_pagemap::store_be<Size>(data_ + offset, value);
+    }
+  }
+
+  unsigned int mmio_read(uint32_t offset, int size) const {
+    const m68k_mmio_read_t fn = size == 4 ? mmio_.read32 : size == 2 ? mmio_.read16 : mmio_.read8;
+    if (fn) {
+      return fn(context_, offset);
+    }
+    if (size == 1) {
+      return 0;
+    }
+    const int half = size / 2;
+    const unsigned int hi = mmio_read(offset, half);
+    const unsigned int lo = mmio_read(offset + half, half);
+    return (hi << (half * 8)) | lo;
+  }
+
+  void mmio_write(uint32_t offset, int size, unsigned int value) const {
+    const m68k_mmio_write_t fn = size == 4 ? mmio_.write32 : size == 2 ? mmio_.write16 : mmio_.write8;
+    if (fn) {
+      fn(context_, offset, value);
+      return;
+    }
+    if (size == 1) {
+      return;
+    }
+    const int half = size / 2;
+    const unsigned int mask = half == 2 ? 0xFFFFu : 0xFFu;
+    mmio_write(offset, half, (value >> (half * 8)) & mask);
+    mmio_write(offset + half, half, value & mask);
+  }
 };
 static std::vector<Region> _regions;
+
+// First region holding the access, following mirrors to the memory they
+// alias (address is updated; writes mark each hop dirty and watched). The
+// chain is walked here instead of by re-entering my_read_memory /
+// my_write_memory, so no lookup state is live when the final access raises
+// a bus error and longjmps out. Null when no region holds the access or the
+// chain is longer than kMaxMirrorDepth (*dropped is then set).
+static Region* resolve_region(unsigned int& address, int size, bool write, bool* dropped) {
+  *dropped = false;
+  for (int hops = 0;; ++hops) {
+    Region* hit = nullptr;
+    for (auto& region : _regions) {
+      if (region.contains(address, size)) {
+        hit = &region;
+        break;
+      }
+    }
+    if (!hit || hit->kind_ != M68K_REGION_MIRROR) {
+      return hit;
+    }
+    if (hops == kMaxMirrorDepth) {
+      *dropped = true;
+      return nullptr;
+    }
+    address = hit->mirror_target(address);
+    if (write) {
+      m68k_dirty_note_write(address, static_cast<uint32_t>(size));
+      m68k_timetravel_note_write(address, size);
+    }
+  }
+}
+static int _next_region_handle = 1;
+
+// Wait cycles charged while executing, indexed by region handle; sized when
+// wait states are set so charging never allocates
+static std::vector<uint64_t> _wait_cycles;
+
+static void charge_wait(int handle, uint32_t cycles) {
+  if (!m68k_history_in_slice()) {
+    return;
+  }
+  m68k_use_cycles(static_cast<int>(cycles));
+  _wait_cycles[handle] += cycles;
+}
+
+static inline uint32_t bus_cycles(int size) {
+  return size == 4 ? 2 : 1;
+}
+
+// Direct pages mirror _regions' lookup order. Debug logging reports region
+// hits from the scan, so it keeps every page on the slow path.
+static void rebuild_pagemap() {
+  m68k_pagemap::clear();
+  m68k_pagemap::g_wait_observer = charge_wait;
+  if (_enable_printf_logging) {
+    return;
+  }
+  for (const auto& region : _regions) {
+    switch (region.kind_) {
+      case M68K_REGION_RAM:
+        m68k_pagemap::add(region.start_, region.size_, region.data_, region.data_, region.flags_,
+                          region.handle_, region.wait_);
+        break;
+      case M68K_REGION_ROM:
+        m68k_pagemap::add(region.start_, region.size_, region.data_, nullptr, region.flags_,
+                          region.handle_, region.wait_);
+        break;
+      case M68K_REGION_MIRROR:
+        m68k_pagemap::alias(region.start_, region.size_, mask_address(region.target_));
+        break;
+      case M68K_REGION_MMIO:
+        m68k_pagemap::add(region.start_, region.size_, nullptr, nullptr, 0, region.handle_, 0);
+        break;
+    }
+  }
+  m68k_pagemap::resolve_aliases();
+}
+
+static int add_region_entry(Region region) {
+  region.handle_ = _next_region_handle++;
+  _regions.push_back(region);
+  rebuild_pagemap();
+  return region.handle_;
+}
+
+// What accesses no region claims do, per 4 KB page. Pages without an entry
+// use the default; with no entries and a host default nothing is looked up.
+static int _unmapped_default = M68K_UNMAPPED_HOST;
+static std::unordered_map<unsigned int, uint8_t> _unmapped_pages;
+static unsigned int _open_bus_word = 0xFFFF;
+
+struct UnmappedAccess {
+  unsigned int address;
+  unsigned int size;
+  int write;    // -1 until the first non-host access
+};
+static UnmappedAccess _last_unmapped = {0, 0, -1};
+
+static inline int unmapped_policy(unsigned int address) {
+  if (_unmapped_default == M68K_UNMAPPED_HOST && _unmapped_pages.empty()) {
+    return M68K_UNMAPPED_HOST;
+  }
+  const auto it = _unmapped_pages.find(mask_address(address) >> m68k_pagemap::kPageShift);
+  return it != _unmapped_pages.end() ? it->second : _unmapped_default;
+}
+
+static unsigned int open_bus_value(unsigned int address, int size) {
+  switch (size) {
+    case 1: return (address & 1) ? (_open_bus_word & 0xFF) : ((_open_bus_word >> 8) & 0xFF);
+    case 2: return _open_bus_word;
+    case 4: return (_open_bus_word << 16) | _open_bus_word;
+    default: return 0;
+  }
+}
+
+// Non-host pages never reach the host callbacks. A bus error unwinds out of
+// here through m68k_pulse_bus_error; a second one while the exception frame
+// is being written reads open bus rather than recursing.
+static unsigned int unmapped_access(int policy, unsigned int address, int size, bool write) {
+  _last_unmapped = {address, static_cast<unsigned int>(size), write ? 1 : 0};
+  if (write) {
+    m68k_bridge_note_write(M68K_BRIDGE_PATH_NONE, size, address);
+  } else {
+    m68k_bridge_note_read(M68K_BRIDGE_PATH_NONE, size, address);
+  }
+  if (m68k_history_in_slice()) {
+    if (policy == M68K_UNMAPPED_BUS_ERROR && !m68k_fault_writing_frame()) {
+      m68k_fault_note_bus_access(address, static_cast<uint32_t>(size), write);
+      m68k_pulse_bus_error();
+    } else if (policy == M68K_UNMAPPED_BREAK) {
+      finalize_break_request(BreakReason::Unmapped, true);
+    }
+  }
+  return write ? 0 : open_bus_value(address, size);
+}
 static std::unordered_map<unsigned int, std::string> _function_names;
 static std::unordered_map<unsigned int, std::string> _memory_names;
 
@@ -343,6 +608,7 @@ extern "C" {
   void enable_printf_logging() {
     printf("enable_printf_logging\n");
     _enable_printf_logging = true;
+    rebuild_pagemap();
   }
   void set_read_mem_func(read_mem_t func) {
     if (_enable_printf_logging)
@@ -376,14 +642,32 @@ extern "C" {
       printf("set_write8_callback: %p\n", (void*)fp);
   }
   
+  // Sized variants are optional and only used alongside the 8-bit ones;
+  // pass 0 to go back to byte composition for that size
+  void set_read16_callback(int32_t fp) {
+    js_read16_callback = (read_sized_callback_t)(uintptr_t)fp;
+  }
+
+  void set_read32_callback(int32_t fp) {
+    js_read32_callback = (read_sized_callback_t)(uintptr_t)fp;
+  }
+
+  void set_write16_callback(int32_t fp) {
+    js_write16_callback = (write_sized_callback_t)(uintptr_t)fp;
+  }
+
+  void set_write32_callback(int32_t fp) {
+    js_write32_callback = (write_sized_callback_t)(uintptr_t)fp;
+  }
+
   void set_probe_callback(int32_t fp) {
     js_probe_callback = (probe_callback_t)fp;
     if (_enable_printf_logging)
       printf("set_probe_callback: %p\n", (void*)fp);
   }
-  // Normalize to 24-bit, even address (68k opcodes are word-aligned)
+  // Normalize to the address width, even address (68k opcodes are word-aligned)
   static inline uint32_t norm_pc(uint32_t a) {
-    return (a & 0x00FFFFFEu);
+    return mask_address(a) & kEvenMask;
   }
   
   void add_pc_hook_addr(unsigned int addr) {
@@ -391,12 +675,12 @@ extern "C" {
       printf("add_pc_hook_addr: %p (normalized: %p)\n", (void*)addr, (void*)norm_pc(addr));
     _pc_hook_addrs.insert(norm_pc(addr));
   }
-  void add_region(unsigned int start, unsigned int size, void* data) {
+  int add_region(unsigned int start, unsigned int size, void* data) {
     if (_enable_printf_logging) {
       printf("DEBUG: add_region called: start=0x%x size=0x%x data=%p (regions before: %zu)\n", 
              start, size, data, _regions.size());
     }
-    _regions.emplace_back(start, size, data);
+    const int handle = add_region_entry(Region(0, M68K_REGION_RAM, start, size, data));
     
     // Debug: verify the region was added properly
     if (_enable_printf_logging) {
@@ -404,9 +688,269 @@ extern "C" {
       printf("DEBUG: Region added successfully: start_=0x%x size_=0x%x data_=%p (total regions: %zu)\n", 
              r.start_, r.size_, (void*)r.data_, _regions.size());
     }
+    return handle;
+  }
+  // Word-swapped region: data is a big-endian image that is converted in
+  // place to host 16-bit word order, so aligned word accesses (including
+  // every instruction fetch) are plain native loads. The buffer stays in
+  // that order while mapped; get_region_info reports it as-is and
+  // get_region_swapped tells callers to convert. start and size must be even.
+  int add_region_swapped(unsigned int start, unsigned int size, void* data) {
+    if ((start | size) & 1u || !data) {
+      return -1;
+    }
+    uint32_t flags = 0;
+    if (!m68k_pagemap::kHostBigEndian) {
+      m68k_pagemap::swap_words(static_cast<uint8_t*>(data), size);
+      flags = m68k_pagemap::kPageSwapped;
+    }
+    return add_region_entry(Region(0, M68K_REGION_RAM, start, size, data, flags));
+  }
+  int add_rom_region(unsigned int start, unsigned int size, void* data, int write_policy) {
+    if (!data || (write_policy != M68K_ROM_WRITE_IGNORE && write_policy != M68K_ROM_WRITE_FAULT)) {
+      return -1;
+    }
+    Region region(0, M68K_REGION_ROM, start, size, data);
+    region.rom_write_policy_ = write_policy;
+    return add_region_entry(region);
+  }
+  int add_mirror_region(unsigned int start, unsigned int size, unsigned int target) {
+    if (size == 0 || target == start) {
+      return -1;
+    }
+    Region region(0, M68K_REGION_MIRROR, start, size, nullptr);
+    region.target_ = target;
+    return add_region_entry(region);
+  }
+  int add_mmio_region(unsigned int start, unsigned int size,
+                      const m68k_mmio_handlers_t* handlers, void* context) {
+    if (size == 0 || !handlers) {
+      return -1;
+    }
+    Region region(0, M68K_REGION_MMIO, start, size, nullptr);
+    region.mmio_ = *handlers;
+    region.context_ = context;
+    return add_region_entry(region);
+  }
+  int add_banked_region(unsigned int start, unsigned int window_size, void* backing,
+                        unsigned int backing_size, int kind) {
+    if (!backing || window_size == 0 || window_size > backing_size ||
+        (kind != M68K_REGION_RAM && kind != M68K_REGION_ROM)) {
+      return -1;
+    }
+    Region region(0, static_cast<m68k_region_kind>(kind), start, window_size, backing);
+    region.bank_base_ = static_cast<uint8_t*>(backing);
+    region.bank_size_ = backing_size;
+    return add_region_entry(region);
+  }
+  int remap_bank(int handle, unsigned int backing_offset) {
+    for (auto& region : _regions) {
+      if (region.handle_ != handle) {
+        continue;
+      }
+      if (!region.bank_base_ ||
+          static_cast<uint64_t>(backing_offset) + region.size_ > region.bank_size_) {
+        return -1;
+      }
+      region.data_ = region.bank_base_ + backing_offset;
+      m68k_pagemap::retarget(handle, region.start_, region.size_, region.data_,
+                             region.kind_ == M68K_REGION_RAM ? region.data_ : nullptr);
+      return 0;
+    }
+    return -1;
+  }
+  int remove_region(int handle) {
+    for (auto it = _regions.begin(); it != _regions.end(); ++it) {
+      if (it->handle_ == handle) {
+        _regions.erase(it);
+        rebuild_pagemap();
+        return 0;
+      }
+    }
+    return -1;
+  }
+  // Bulk copies page by page: direct pages are memcpy'd (byte-swapped for
+  // host word order storage), anything else goes byte by byte through the
+  // region scan and host callbacks. Addresses wrap at the configured width.
+  int read_block(unsigned int address, unsigned int length, void* dst) {
+    if (!dst && length) {
+      return -1;
+    }
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    for (unsigned int done = 0; done < length;) {
+      const uint32_t a = mask_address(address + done);
+      const uint32_t offset = a & m68k_pagemap::kPageMask;
+      const uint32_t n = std::min<uint32_t>(length - done, m68k_pagemap::kPageSize - offset);
+      const m68k_pagemap::Page& page = m68k_pagemap::page_for(a);
+      if (page.read && (page.flags & m68k_pagemap::kPageSwapped)) {
+        for (uint32_t i = 0; i < n; ++i) {
+          out[done + i] = static_cast<uint8_t>(m68k_pagemap::swapped_byte(page.read, offset + i));
+        }
+      } else if (page.read) {
+        std::memcpy(out + done, page.read + offset, n);
+      } else {
+        for (uint32_t i = 0; i < n; ++i) {
+          out[done + i] = static_cast<uint8_t>(my_read_memory(a + i, 1));
+        }
+      }
+      done += n;
+    }
+    return 0;
+  }
+  int write_block(unsigned int address, unsigned int length, const void* src) {
+    if (!src && length) {
+      return -1;
+    }
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    for (unsigned int done = 0; done < length;) {
+      const uint32_t a = mask_address(address + done);
+      const uint32_t offset = a & m68k_pagemap::kPageMask;
+      const uint32_t n = std::min<uint32_t>(length - done, m68k_pagemap::kPageSize - offset);
+      const m68k_pagemap::Page& page = m68k_pagemap::page_for(a);
+      m68k_pagemap::note_dirty(a, n);
+      if (page.write) {
+        m68k_timetravel_note_write(a, static_cast<int>(n));
+        if (page.flags & m68k_pagemap::kPageSwapped) {
+          for (uint32_t i = 0; i < n; ++i) {
+            m68k_pagemap::store_swapped<1>(page.write, offset + i, in[done + i]);
+          }
+        } else {
+          std::memcpy(page.write + offset, in + done, n);
+        }
+      } else {
+        for (uint32_t i = 0; i < n; ++i) {
+          my_write_memory(a + i, 1, in[done + i]);
+        }
+      }
+      done += n;
+    }
+    return 0;
+  }
+  int set_region_wait_states(int handle, unsigned int wait) {
+    for (auto& region : _regions) {
+      if (region.handle_ != handle) {
+        continue;
+      }
+      if (region.kind_ == M68K_REGION_MIRROR) {
+        return -1;
+      }
+      if (_wait_cycles.size() <= static_cast<size_t>(handle)) {
+        _wait_cycles.resize(static_cast<size_t>(handle) + 1, 0);
+      }
+      region.wait_ = wait;
+      rebuild_pagemap();
+      return 0;
+    }
+    return -1;
+  }
+  int get_region_wait_cycles(int handle, uint32_t* lo, uint32_t* hi) {
+    for (const auto& region : _regions) {
+      if (region.handle_ != handle) {
+        continue;
+      }
+      const uint64_t total =
+          static_cast<size_t>(handle) < _wait_cycles.size() ? _wait_cycles[handle] : 0;
+      if (lo) *lo = static_cast<uint32_t>(total);
+      if (hi) *hi = static_cast<uint32_t>(total >> 32);
+      return 0;
+    }
+    return -1;
+  }
+  void reset_wait_cycles() {
+    std::fill(_wait_cycles.begin(), _wait_cycles.end(), 0);
+  }
+  int get_region_dirty_pages(int handle) {
+    for (const auto& region : _regions) {
+      if (region.handle_ == handle) {
+        return static_cast<int>(m68k_dirty_count(region.start_, region.size_));
+      }
+    }
+    return -1;
+  }
+  int get_region_swapped(unsigned int index) {
+    if (index >= _regions.size()) {
+      return -1;
+    }
+    return (_regions[index].flags_ & m68k_pagemap::kPageSwapped) ? 1 : 0;
+  }
+  int get_region_bank(unsigned int index, void** backing, unsigned int* backing_size,
+                      unsigned int* backing_offset) {
+    if (index >= _regions.size() || !_regions[index].bank_base_) {
+      return -1;
+    }
+    const auto& region = _regions[index];
+    if (backing) *backing = region.bank_base_;
+    if (backing_size) *backing_size = region.bank_size_;
+    if (backing_offset) *backing_offset = static_cast<unsigned int>(region.data_ - region.bank_base_);
+    return 0;
+  }
+  int get_region_kind(unsigned int index) {
+    return index < _regions.size() ? static_cast<int>(_regions[index].kind_) : -1;
+  }
+  int get_region_handle(unsigned int index) {
+    return index < _regions.size() ? _regions[index].handle_ : -1;
+  }
+  int m68k_set_address_width(int bits) {
+    if (bits != 24 && bits != 32) {
+      return -1;
+    }
+    m68k_pagemap::g_address_mask = bits == 32 ? 0xFFFFFFFFu : kAddr24Mask;
+    rebuild_pagemap();
+    return 0;
+  }
+  int m68k_get_address_width() {
+    return m68k_pagemap::g_address_mask == kAddr24Mask ? 24 : 32;
   }
   void clear_regions() {
     _regions.clear();
+    rebuild_pagemap();
+  }
+  int set_unmapped_policy(unsigned int start, unsigned int size, int policy) {
+    if (policy < M68K_UNMAPPED_HOST || policy > M68K_UNMAPPED_BREAK) {
+      return -1;
+    }
+    if (size == 0) {
+      return 0;
+    }
+    const uint64_t end = static_cast<uint64_t>(start) + size;
+    const uint64_t limit = static_cast<uint64_t>(m68k_pagemap::g_address_mask) + 1;
+    for (uint64_t page = start >> m68k_pagemap::kPageShift;
+         (page << m68k_pagemap::kPageShift) < end &&
+         (page << m68k_pagemap::kPageShift) < limit;
+         ++page) {
+      _unmapped_pages[static_cast<unsigned int>(page)] = static_cast<uint8_t>(policy);
+    }
+    return 0;
+  }
+  int set_unmapped_default(int policy) {
+    if (policy < M68K_UNMAPPED_HOST || policy > M68K_UNMAPPED_BREAK) {
+      return -1;
+    }
+    _unmapped_default = policy;
+    return 0;
+  }
+  void set_open_bus_value(unsigned int word) {
+    _open_bus_word = word & 0xFFFF;
+  }
+  int get_last_unmapped_access(unsigned int* address, unsigned int* size) {
+    if (_last_unmapped.write >= 0) {
+      if (address) *address = _last_unmapped.address;
+      if (size) *size = _last_unmapped.size;
+    }
+    return _last_unmapped.write;
+  }
+  unsigned int get_region_count() {
+    return static_cast<unsigned int>(_regions.size());
+  }
+  int get_region_info(unsigned int index, unsigned int* start, unsigned int* size, void** data) {
+    if (index >= _regions.size()) {
+      return -1;
+    }
+    const auto& region = _regions[index];
+    if (start) *start = region.start_;
+    if (size) *size = region.size_;
+    if (data) *data = region.data_;
+    return 0;
   }
   void clear_pc_hook_addrs() {
     _pc_hook_addrs.clear();
@@ -443,12 +987,33 @@ extern "C" {
     _instr_hook = nullptr;
     _pc_hook_addrs.clear();
     _regions.clear();
+    _wait_cycles.clear();
+    _unmapped_default = M68K_UNMAPPED_HOST;
+    _unmapped_pages.clear();
+    _open_bus_word = 0xFFFF;
+    _last_unmapped = {0, 0, -1};
+    m68k_pagemap::g_address_mask = kAddr24Mask;
+    rebuild_pagemap();
     _function_names.clear();
     _memory_names.clear();
     _memory_ranges.clear();
     _memory_range_cache.clear();
     _exec_session = SentinelSession{};
     m68k_fault_clear();
+    m68k_history_clear();
+    m68k_history_set_pc_tracking(0);
+    m68k_callstack_clear();
+    m68k_stack_clear_regions();
+    m68k_irqlat_reset();
+    m68k_hookcost_enable(0);
+    m68k_hookcost_reset();
+    m68k_bridge_track_slow_pages(0);
+    m68k_bridge_stats_reset();
+    m68k_dirty_enable(0);
+    m68k_timetravel_disable();
+    m68k_replay_stop();
+    m68k_memo_disable_all();
+    m68k_fingerprint_disable();
   }
   
   /* ======================================================================== */
@@ -578,6 +1143,18 @@ extern "C" {
   unsigned long long m68k_call_until_js_stop(unsigned int entry_pc, unsigned int timeslice) {
     if (timeslice == 0) timeslice = kDefaultTimeslice;
     SessionGuard guard(entry_pc);
+
+    // Opted-in pure routines may be answered from the memo cache
+    unsigned long long memo_cycles = 0;
+    if (m68k_memo_lookup(entry_pc, &memo_cycles)) {
+      _exec_session.done = true;
+      _exec_session.markConsumed();
+      _last_break_reason = BreakReason::Sentinel;
+      _exec_session.finalize();
+      return memo_cycles;
+    }
+    m68k_memo_begin(entry_pc, _exec_session.sentinel_pc);
+
     if (_enable_printf_logging) {
       const unsigned int sp_start = m68k_get_reg(nullptr, M68K_REG_SP);
       printf("call_until_js_stop: start pc=0x%08X sp=0x%08X timeslice=%u\n",
@@ -595,6 +1172,7 @@ extern "C" {
       }
       ++iter;
     }
+    m68k_memo_end(_last_break_reason == BreakReason::Sentinel, total_cycles);
     _exec_session.finalize();
     if (_enable_printf_logging) {
       const unsigned int sp_end = m68k_get_reg(nullptr, M68K_REG_SP);
@@ -691,22 +1269,50 @@ extern "C" {
 
 extern "C" unsigned int my_read_memory(unsigned int address, int size) {
   // Check regions first
-  for (auto& region : _regions) {
-    const auto val = region.read(address, size);
+  bool dropped = false;
+  if (Region* region = resolve_region(address, size, false, &dropped)) {
+    // Device reads are inputs like host reads: logged while recording and
+    // served from the replay log during playback
+    const bool device = region->kind_ == M68K_REGION_MMIO && region->contains(address, size);
+    unsigned int replayed = 0;
+    const bool from_log = device && m68k_replay_fetch_read(address, size, &replayed);
+    const auto val = from_log ? std::optional<unsigned int>(replayed) : region->read(address, size);
     if (val) {
       if (_enable_printf_logging && address < 0x100) {
         printf("DEBUG: my_read_memory region hit: addr=0x%x size=%d value=0x%x (region start=0x%x)\n", 
-               address, size, *val, region.start_);
+               address, size, *val, region->start_);
+      }
+      m68k_bridge_note_read(from_log ? M68K_BRIDGE_PATH_REPLAY : region->path(), size, address);
+      if (region->wait_) {
+        charge_wait(region->handle_, region->wait_ * bus_cycles(size));
+      }
+      if (device) {
+        m68k_replay_log_read(address, size, *val);
       }
       return *val;
     }
+  } else if (dropped) {
+    return 0;
   }
   
+  const int unmapped = unmapped_policy(address);
+  if (unmapped != M68K_UNMAPPED_HOST) {
+    return unmapped_access(unmapped, address, size, false);
+  }
+
+  // Host-backed reads are served from the replay log during playback
+  unsigned int result = 0;
+  if (m68k_replay_fetch_read(address, size, &result)) {
+    m68k_bridge_note_read(M68K_BRIDGE_PATH_REPLAY, size, address);
+    return result;
+  }
+
   // Try JS callback (big-endian composition)
   if (js_read8_callback) {
-    unsigned int result;
+    m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_JS_READ);
+    m68k_bridge_note_read(M68K_BRIDGE_PATH_JS, size, address);
     switch(size) {
-      case 1: result = js_read8_callback(addr24(address)); break;
+      case 1: result = js_read8_callback(mask_address(address)); break;
       case 2: result = read16_be(address); break;
       case 4: result = read32_be(address); break;
       default: result = 0; break;
@@ -715,40 +1321,69 @@ extern "C" unsigned int my_read_memory(unsigned int address, int size) {
       printf("DEBUG: my_read_memory JS callback: addr=0x%x size=%d value=0x%x\n", 
              address, size, result);
     }
-    return result;
-  }
-  
-  // Fall back to old callback system
-  if (_read_mem) {
-    unsigned int result = _read_mem(address, size);
+  } else if (_read_mem) {
+    // Fall back to old callback system
+    m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_READ_MEM);
+    m68k_bridge_note_read(M68K_BRIDGE_PATH_LEGACY, size, address);
+    result = _read_mem(address, size);
     if (_enable_printf_logging && address < 0x100) {
       printf("DEBUG: my_read_memory old callback: addr=0x%x size=%d value=0x%x callback=%p\n", 
              address, size, result, (void*)_read_mem);
     }
-    return result;
-  }
-  
-  if (_enable_printf_logging && address < 0x100) {
-    printf("DEBUG: my_read_memory NO HANDLER: addr=0x%x size=%d, %zu regions, callback=%p\n", 
-           address, size, _regions.size(), (void*)_read_mem);
+  } else {
+    m68k_bridge_note_read(M68K_BRIDGE_PATH_NONE, size, address);
+    if (_enable_printf_logging && address < 0x100) {
+      printf("DEBUG: my_read_memory NO HANDLER: addr=0x%x size=%d, %zu regions, callback=%p\n", 
+             address, size, _regions.size(), (void*)_read_mem);
+    }
   }
-  return 0; // Return 0 if no handler is set
+
+  m68k_replay_log_read(address, size, result);
+  return result; // 0 if no handler is set
 }
 
 // Memory access callbacks are now in m68k_memory_bridge.cc
 
 extern "C" void my_write_memory(unsigned int address, int size, unsigned int value) {
+  m68k_timetravel_note_write(address, size);
+
   // Check regions first
-  for (auto& region : _regions) {
-    if (region.write(address, size, value)) {
+  bool dropped = false;
+  if (Region* region = resolve_region(address, size, true, &dropped)) {
+    // Devices, like host callbacks, must not see writes replayed from history
+    const bool silenced = region->kind_ == M68K_REGION_MMIO && m68k_replay_is_playing() &&
+                          region->contains(address, size);
+    if (silenced || region->write(address, size, value)) {
+      m68k_bridge_note_write(silenced || region->kind_ == M68K_REGION_ROM ? M68K_BRIDGE_PATH_NONE
+                                                                          : region->path(),
+                             size, address);
+      if (region->wait_) {
+        charge_wait(region->handle_, region->wait_ * bus_cycles(size));
+      }
       return; // Write handled by region
     }
+  } else if (dropped) {
+    return;
   }
   
+  const int unmapped = unmapped_policy(address);
+  if (unmapped != M68K_UNMAPPED_HOST) {
+    unmapped_access(unmapped, address, size, true);
+    return;
+  }
+
+  // Playback replays host reads from the log; host devices must not see writes
+  if (m68k_replay_is_playing()) {
+    m68k_bridge_note_write(M68K_BRIDGE_PATH_NONE, size, address);
+    return;
+  }
+
   // Try JS callback (big-endian decomposition)
   if (js_write8_callback) {
+    m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_JS_WRITE);
+    m68k_bridge_note_write(M68K_BRIDGE_PATH_JS, size, address);
     switch(size) {
-      case 1: js_write8_callback(addr24(address), value & 0xFF); break;
+      case 1: js_write8_callback(mask_address(address), value & 0xFF); break;
       case 2: write16_be(address, value & 0xFFFF); break;
       case 4: write32_be(address, value); break;
     }
@@ -757,7 +1392,11 @@ extern "C" void my_write_memory(unsigned int address, int size, unsigned int val
   
   // Fall back to old callback system
   if (_write_mem) {
+    m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_WRITE_MEM);
+    m68k_bridge_note_write(M68K_BRIDGE_PATH_LEGACY, size, address);
     _write_mem(address, size, value);
+  } else {
+    m68k_bridge_note_write(M68K_BRIDGE_PATH_NONE, size, address);
   }
 }
 
@@ -791,13 +1430,18 @@ int my_instruction_hook_function(unsigned int pc_raw) {
   // Call JS probe callback if registered, honoring address filter semantics
   if (js_probe_callback) {
     if (should_invoke_pc_hook(pc)) {
-      int js_result = js_probe_callback(pc);
+      int js_result;
+      {
+        m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_PROBE, pc);
+        js_result = js_probe_callback(pc);
+      }
       if (js_result != 0) return js_result;  // JS wants to break
     }
   }
 
   // Call legacy PC hook if present and allowed by filter
   if (_pc_hook && should_invoke_pc_hook(pc)) {
+    m68k_hookcost::ScopedTimer timer(M68K_HOOK_KIND_PC_HOOK, pc);
     return _pc_hook(pc);
   }
 
@@ -820,6 +1464,11 @@ extern "C" int m68k_instruction_hook_wrapper(unsigned int pc, unsigned int ir, u
         }
     }
     
+    // Re-executing history for time travel: host hooks already ran live
+    if (m68k_timetravel_seeking()) {
+        return 0;
+    }
+
 #ifdef BUILD_TESTS
     HookContext ctx{pc, ir, cycles};
     return static_cast<int>(processHooks(ctx, /*allow_break=*/false));
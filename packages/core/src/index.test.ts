@@ -1,6 +1,6 @@
 // ESM-compatible test file using real WASM
 // @ts-nocheck
-import { createSystem, formatFaultContext } from './index.js';
+import { M68kRegister, createSystem, formatFaultContext } from './index.js';
 // Shared test utilities
 import { BreakReason, getLastBreakReasonFrom, resetLastBreakReasonOn } from './test-utils.js';
 
@@ -163,6 +163,22 @@ describe('@m68k/core', () => {
     expect(readData).toEqual(data);
   });
 
+  it('copies contiguous byte arrays in bulk and mirrors RAM writes', () => {
+    const ramBase = 0x100000;
+    const block = new Uint8Array(0xe00).map((_, i) => (i * 13) & 0xff);
+    system.writeBytes(ramBase + 0x100, block);
+    expect(system.ram[0x100 + 0xabc]).toBe(block[0xabc]);
+
+    const copy = system.readBytes(ramBase + 0x100, block.length);
+    expect(copy).toEqual(block);
+    copy[0] ^= 0xff;
+    expect(system.read(ramBase + 0x100, 1)).toBe(block[0]);
+
+    const view = system.peekBytes(ramBase + 0x100, 4);
+    system.write(ramBase + 0x100, 1, 0x99);
+    expect(view[0]).toBe(0x99);
+  });
+
   it('should execute simple instructions', async () => {
     // Execute a few cycles
     const cycles = system.run(100);
@@ -202,6 +218,29 @@ describe('@m68k/core', () => {
     expect(newRegs.a1).toBe(0x100100);
   });
 
+  it('should batch register reads and writes', () => {
+    system.setRegister('d3', 0xdeadbeef);
+    const view = system.registerView();
+    expect(view[M68kRegister.D3]).toBe(0xdeadbeef);
+    expect(view[M68kRegister.SP]).toBe(view[M68kRegister.A7]);
+
+    const regs = view.slice();
+    regs[M68kRegister.D4] = 0x44;
+    regs[M68kRegister.A2] = 0x100200;
+    system.setRegisters(regs);
+
+    const snapshot = system.getRegisters();
+    expect(snapshot.d4).toBe(0x44);
+    expect(snapshot.a2).toBe(0x100200);
+    expect(snapshot.d3).toBe(0xdeadbeef);
+    system.setRegister('d4', 0x55);
+    expect(snapshot.d4).toBe(0x44); // snapshots do not follow the CPU
+    expect(Object.keys(snapshot)).toContain('a2');
+    expect({ ...snapshot, d4: 0x44 }).toEqual(structuredClone(snapshot));
+    snapshot.d0 = 1;
+    expect(snapshot.d0).toBe(1);
+  });
+
   it('should support probe hooks', async () => {
     const addresses: number[] = [];
 
@@ -260,6 +260,17 @@ const REGISTER_MAP: { [K in keyof CpuRegisters]: M68kRegister } = {
   ppc: M68kRegister.PPC,
 };
 
+// Plain register object filled from the batch register file in one pass,
+// so it spreads, clones and compares like the per-register fallback.
+function registersFromView(view: Uint32Array): CpuRegisters {
+  const regs: Partial<CpuRegisters> = {};
+  for (const key in REGISTER_MAP) {
+    const regKey = key as keyof CpuRegisters;
+    regs[regKey] = view[REGISTER_MAP[regKey]];
+  }
+  return regs as CpuRegisters;
+}
+
 class TracerImpl implements Tracer {
   private _musashi: MusashiWrapper;
   private _active = false;
@@ -305,6 +316,7 @@ class TracerImpl implements Tracer {
     this._musashi.perfettoEnableFlow(!!config.flow);
     this._musashi.perfettoEnableMemory(!!config.memory);
     this._musashi.perfettoEnableInstructions(!!config.instructions);
+    this._musashi.perfettoEnableInterrupts(!!config.interrupts);
     this._musashi.perfettoEnableInstructionRegisters(
       wantsInstructionRegisters
     );
@@ -498,6 +510,10 @@ class SystemImpl implements System {
   }
 
   readBytes(address: number, length: number): Uint8Array {
+    const view = this._musashi.readBlock(address, length);
+    if (view) {
+      return view.slice();
+    }
     const buffer = new Uint8Array(length);
     for (let i = 0; i < length; i++) {
       buffer[i] = this.read(address + i, 1);
@@ -505,13 +521,24 @@ class SystemImpl implements System {
     return buffer;
   }
 
+  peekBytes(address: number, length: number): Uint8Array {
+    return this._musashi.readBlock(address, length) ?? this.readBytes(address, length);
+  }
+
   writeBytes(address: number, data: Uint8Array): void {
+    if (this._musashi.writeBlock(address, data)) {
+      return;
+    }
     for (let i = 0; i < data.length; i++) {
       this.write(address + i, 1, data[i]);
     }
   }
 
   getRegisters(): CpuRegisters {
+    const view = this._musashi.readAllRegisters();
+    if (view) {
+      return registersFromView(view);
+    }
     const regs: Partial<CpuRegisters> = {};
     for (const key in REGISTER_MAP) {
       const regKey = key as keyof CpuRegisters;
@@ -520,6 +547,28 @@ class SystemImpl implements System {
     return regs as CpuRegisters;
   }
 
+  registerView(): Uint32Array {
+    const view = this._musashi.readAllRegisters();
+    if (view) {
+      return view;
+    }
+    const regs = new Uint32Array(M68kRegister.PPC + 1);
+    for (let i = 0; i < regs.length; i++) {
+      regs[i] = this._musashi.get_reg(i as M68kRegister);
+    }
+    return regs;
+  }
+
+  setRegisters(regs: ArrayLike<number>): void {
+    if (this._musashi.writeAllRegisters(regs)) {
+      return;
+    }
+    for (const key in REGISTER_MAP) {
+      const index = REGISTER_MAP[key as keyof CpuRegisters];
+      this._musashi.set_reg(index, regs[index]);
+    }
+  }
+
   setRegister<K extends keyof CpuRegisters>(register: K, value: number): void {
     const index = REGISTER_MAP[register];
     if (index !== undefined) {
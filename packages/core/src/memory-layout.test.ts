@@ -60,6 +60,11 @@ describe('Unified memory layout (regions + mirrors)', () => {
     expect(system.read(mirStart + 0x1234, 1) & 0xff).toBe(rom[r2Off + 0x1234]);
     // Capacity: highest covered address is within readable range
     expect(system.read(mirStart + 0x7fff, 1) & 0xff).toBe(rom[r2Off + 0x7fff]);
+    // Mirrors alias rather than copy: writes through either side are shared
+    system.write(r2Start + 0x40, 2, 0xbeef);
+    expect(system.read(mirStart + 0x40, 2)).toBe(0xbeef);
+    system.write(mirStart + 0x80, 1, 0x5a);
+    expect(system.read(r2Start + 0x80, 1) & 0xff).toBe(0x5a);
 
     // RAM reflection: region at 0x300000 from RAM offset 0x2000
     const ramStart = 0x300000;
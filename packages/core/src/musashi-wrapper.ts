@@ -8,6 +8,8 @@ import type { MemoryLayout, MemoryTraceSource } from './types.js';
 import { mask24 } from './address-utils.js';
 
 const NULL_EMSCRIPTEN_FUNCTION: EmscriptenFunction = 0;
+// Entries in the batch register file (M68K_ALL_REGS_COUNT in m68k.h)
+const ALL_REGS_COUNT = M68kRegister.PPC + 1;
 
 type RuntimeTag = 'node' | 'browser';
 
@@ -69,7 +71,17 @@ const parseBooleanEnv = (value: string | undefined): boolean => {
 export interface MusashiEmscriptenModule {
   _my_initialize(): boolean;
   _add_pc_hook_addr(addr: number): void;
-  _add_region(start: number, len: number, buf: EmscriptenBuffer): void;
+  _add_region(start: number, len: number, buf: EmscriptenBuffer): number;
+  _remove_region?(handle: number): number;
+  _add_banked_region?(start: number, windowSize: number, backing: number, backingSize: number, kind: number): number;
+  _remap_bank?(handle: number, backingOffset: number): number;
+  _set_region_wait_states?(handle: number, wait: number): number;
+  _get_region_wait_cycles?(handle: number, lo: number, hi: number): number;
+  _reset_wait_cycles?(): void;
+  _set_unmapped_policy?(start: number, size: number, policy: number): number;
+  _set_unmapped_default?(policy: number): number;
+  _set_open_bus_value?(word: number): void;
+  _get_last_unmapped_access?(address: number, size: number): number;
   _m68k_execute(cycles: number): number;
   _m68k_cycles_run?(): number;
   _m68k_step_one(): number;
@@ -78,6 +90,8 @@ export interface MusashiEmscriptenModule {
   _m68k_pulse_reset(): void;
   _m68k_set_context(context: number): void;
   _m68k_set_reg(index: number, value: number): void;
+  _m68k_get_all_regs?(regs: EmscriptenBuffer): void;
+  _m68k_set_all_regs?(regs: EmscriptenBuffer): void;
   _malloc(size: number): EmscriptenBuffer;
   _free(ptr: EmscriptenBuffer): void;
   _set_pc_hook_func(f: EmscriptenFunction): void;
@@ -103,6 +117,7 @@ export interface MusashiEmscriptenModule {
   _m68k_perfetto_enable_memory?(enable: number): void;
   _m68k_perfetto_enable_instructions?(enable: number): void;
   _m68k_perfetto_enable_instruction_registers?(enable: number): void;
+  _m68k_perfetto_enable_interrupts?(enable: number): void;
   _m68k_perfetto_export_trace?(
     data_out: EmscriptenBuffer,
     size_out: EmscriptenBuffer
@@ -125,6 +140,10 @@ export interface MusashiEmscriptenModule {
   // New callback system
   _set_read8_callback?(f: EmscriptenFunction): void;
   _set_write8_callback?(f: EmscriptenFunction): void;
+  _set_read16_callback?(f: EmscriptenFunction): void;
+  _set_read32_callback?(f: EmscriptenFunction): void;
+  _set_write16_callback?(f: EmscriptenFunction): void;
+  _set_write32_callback?(f: EmscriptenFunction): void;
   _set_probe_callback?(f: EmscriptenFunction): void;
   // Disassembler entry point (optional export)
   _m68k_disassemble?(
@@ -195,6 +214,8 @@ export class MusashiWrapper {
   private _system!: SystemBridge; // Reference to SystemImpl
   private _memory: Uint8Array = new Uint8Array(0); // allocated in init()
   private _ramWindows: Array<{ start: number; length: number; offset: number }> = [];
+  // Mirrors alias their source span: accesses are translated, nothing is copied
+  private _mirrors: Array<{ start: number; length: number; from: number }> = [];
   private _readFunc: EmscriptenFunction = 0;
   private _writeFunc: EmscriptenFunction = 0;
   private _probeFunc: EmscriptenFunction = 0;
@@ -202,6 +223,9 @@ export class MusashiWrapper {
   private _memTraceActive = false;
   private readonly _traceAvailable: boolean;
   private _faultRecordPtr = 0;
+  // Register file buffer for m68k_get_all_regs / m68k_set_all_regs
+  private _regsPtr: EmscriptenBuffer = 0;
+  private _regsView: Uint32Array | null = null;
   private _pendingHandlerFault: PendingHandlerFault | null = null;
   // No JS sentinel state; C++ session owns sentinel behavior.
   // CPU type for disassembler (68000)
@@ -243,6 +267,7 @@ export class MusashiWrapper {
     const DEFAULT_CAPACITY = 2 * 1024 * 1024; // 2MB
     let capacity = DEFAULT_CAPACITY >>> 0;
     this._ramWindows = [];
+    this._mirrors = [];
 
     if (layout) {
       let maxEnd = 0;
@@ -253,10 +278,8 @@ export class MusashiWrapper {
         const end = (start + length) >>> 0;
         if (end > maxEnd) maxEnd = end;
       }
+      // Mirror destinations need no backing; only their sources do
       for (const m of layout.mirrors ?? []) {
-        const destStart = m.start >>> 0;
-        const destEnd = (destStart + (m.length >>> 0)) >>> 0;
-        if (destEnd > maxEnd) maxEnd = destEnd;
         const srcStart = m.mirrorFrom >>> 0;
         const srcEnd = (srcStart + (m.length >>> 0)) >>> 0;
         if (srcEnd > maxEnd) maxEnd = srcEnd;
@@ -302,11 +325,10 @@ export class MusashiWrapper {
         const length = m.length >>> 0;
         const from = m.mirrorFrom >>> 0;
         if (length === 0) continue;
-        if (from + length > this._memory.length || start + length > this._memory.length) {
+        if (from + length > this._memory.length || start + length > 0x1_0000_0000) {
           throw new Error(`Mirror out of bounds: from=0x${from.toString(16)}, start=0x${start.toString(16)}, len=0x${length.toString(16)}, cap=0x${this._memory.length.toString(16)}`);
         }
-        const src = this._memory.subarray(from, from + length);
-        this._memory.set(src, start);
+        this._mirrors.push({ start, length, from });
       }
     } else {
       // Backward-compatible default mapping
@@ -407,6 +429,11 @@ export class MusashiWrapper {
       this._memTraceFunc = NULL_EMSCRIPTEN_FUNCTION;
       this._memTraceActive = false;
     }
+    if (this._regsPtr) {
+      this._module._free(this._regsPtr);
+      this._regsPtr = 0;
+      this._regsView = null;
+    }
     this._module._clear_regions?.();
     this._module._clear_pc_hook_addrs?.();
     try {
@@ -504,6 +531,44 @@ export class MusashiWrapper {
     this._module._m68k_set_reg(index, value);
   }
 
+  // Heap view of the register file indexed by M68kRegister (D0..PPC), or
+  // null if the batch exports are missing. Rebuilt if the heap grows.
+  private registerView(): Uint32Array | null {
+    const mod = this._module;
+    if (typeof mod._m68k_get_all_regs !== 'function' || typeof mod._m68k_set_all_regs !== 'function') {
+      return null;
+    }
+    if (this._regsPtr === 0) {
+      this._regsPtr = mod._malloc(ALL_REGS_COUNT * 4);
+    }
+    if (!this._regsView || this._regsView.buffer !== mod.HEAPU32.buffer) {
+      this._regsView = new Uint32Array(mod.HEAPU32.buffer, this._regsPtr, ALL_REGS_COUNT);
+    }
+    return this._regsView;
+  }
+
+  // All registers in one call; the view is shared and overwritten by the next call
+  readAllRegisters(): Uint32Array | null {
+    const view = this.registerView();
+    if (view) {
+      this._module._m68k_get_all_regs!(this._regsPtr);
+    }
+    return view;
+  }
+
+  // Loads D0..PPC (the SP entry is ignored) in one call; false if unsupported
+  writeAllRegisters(regs: ArrayLike<number>): boolean {
+    const view = this.registerView();
+    if (!view) {
+      return false;
+    }
+    for (let i = 0; i < ALL_REGS_COUNT; i++) {
+      view[i] = regs[i] >>> 0;
+    }
+    this._module._m68k_set_all_regs!(this._regsPtr);
+    return true;
+  }
+
   add_pc_hook_addr(addr: number) {
     this._module._add_pc_hook_addr(addr);
   }
@@ -679,6 +744,63 @@ export class MusashiWrapper {
     }
   }
 
+  // Maps a mirrored address onto its source; the first matching mirror wins
+  private resolveMirror(address: number): number {
+    for (const m of this._mirrors) {
+      const delta = (address - m.start) >>> 0;
+      if (delta < m.length) {
+        return (m.from + delta) >>> 0;
+      }
+    }
+    return address;
+  }
+
+  // Resolves [address, address + length) to one contiguous span of unified
+  // memory, or returns -1 when it straddles a mirror or RAM window edge or
+  // runs past the end of memory
+  private resolveSpan(address: number, length: number): number {
+    const start = address >>> 0;
+    const end = start + length;
+    let resolved = start;
+    for (const m of this._mirrors) {
+      if (end <= m.start || start >= m.start + m.length) continue;
+      if (start < m.start || end > m.start + m.length) return -1;
+      resolved = (m.from + (start - m.start)) >>> 0;
+      break;
+    }
+    if (resolved + length > this._memory.length) return -1;
+    for (const w of this._ramWindows) {
+      const disjoint = resolved + length <= w.start || resolved >= w.start + w.length;
+      const inside = resolved >= w.start && resolved + length <= w.start + w.length;
+      if (!disjoint && !inside) return -1;
+    }
+    return resolved;
+  }
+
+  // Live view of guest memory for a contiguous span, or null when the span
+  // needs per-byte handling. Callers must not write through the view.
+  readBlock(address: number, length: number): Uint8Array | null {
+    const start = this.resolveSpan(address, length >>> 0);
+    if (start < 0) return null;
+    return this._memory.subarray(start, start + (length >>> 0));
+  }
+
+  // Copies data into a contiguous span (and its RAM window); returns false
+  // when the span needs per-byte handling
+  writeBlock(address: number, data: Uint8Array): boolean {
+    const start = this.resolveSpan(address, data.length);
+    if (start < 0) return false;
+    this._memory.set(data, start);
+    const window = this.findRamWindowForAddress(start);
+    if (window) {
+      const ram = this._system.ram;
+      const ramIndex = (window.offset + (start - window.start)) >>> 0;
+      const count = Math.max(0, Math.min(data.length, ram.length - ramIndex));
+      ram.set(data.subarray(0, count), ramIndex);
+    }
+    return true;
+  }
+
   private isAccessWithinMemory(address: number, size: 1 | 2 | 4): boolean {
     const addr = address >>> 0;
     if (addr >= this._memory.length) return false;
@@ -719,7 +841,7 @@ export class MusashiWrapper {
   }
 
   read_memory(address: number, size: 1 | 2 | 4): number {
-    const addr = address >>> 0;
+    const addr = this.resolveMirror(address >>> 0);
     if (!this.isAccessWithinMemory(addr, size)) return 0;
     let result: number;
     if (size === 1) {
@@ -744,7 +866,7 @@ export class MusashiWrapper {
   }
 
   write_memory(address: number, size: 1 | 2 | 4, value: number) {
-    const addr = address >>> 0;
+    const addr = this.resolveMirror(address >>> 0);
     // Respect bounds strictly: ignore cross-boundary writes
     if (!this.isAccessWithinMemory(addr, size)) return;
     const maskedValue = value >>> 0;
@@ -765,7 +887,7 @@ export class MusashiWrapper {
   }
 
   readRaw8(address: number): number {
-    const addr = address >>> 0;
+    const addr = this.resolveMirror(address >>> 0);
     if (!this.isAccessWithinMemory(addr, 1)) {
       return 0;
     }
@@ -773,7 +895,7 @@ export class MusashiWrapper {
   }
 
   writeRaw8(address: number, value: number): void {
-    const addr = address >>> 0;
+    const addr = this.resolveMirror(address >>> 0);
     if (!this.isAccessWithinMemory(addr, 1)) {
       return;
     }
@@ -945,6 +1067,10 @@ export class MusashiWrapper {
     this._module._m68k_perfetto_enable_instructions?.(enable ? 1 : 0);
   }
 
+  perfettoEnableInterrupts(enable: boolean) {
+    this._module._m68k_perfetto_enable_interrupts?.(enable ? 1 : 0);
+  }
+
   perfettoEnableInstructionRegisters(enable: boolean) {
     const fn = this._module._m68k_perfetto_enable_instruction_registers;
     if (!fn) {
@@ -7,6 +7,8 @@ export enum BreakReason {
   InstrHook = 2,
   JsHook = 3,
   Sentinel = 4,
+  Step = 5,
+  Unmapped = 6,
 }
 
 // Narrow access to internal Musashi debug hooks without leaking `any`.
@@ -73,6 +73,11 @@ export interface TraceConfig {
   flow?: boolean;
   /** Trace memory write operations. Defaults to false. */
   memory?: boolean;
+  /**
+   * Trace serviced interrupts on per-level tracks (pending time and handler
+   * duration). Defaults to false.
+   */
+  interrupts?: boolean;
 }
 
 /** A map of memory addresses to human-readable names. */
@@ -92,7 +97,7 @@ export type MemoryRegion = {
   sourceOffset?: number;
 };
 
-/** Describes a mirrored region copied from an already initialized span. */
+/** Describes a mirror that aliases an already initialized span; reads and writes through either address see the same bytes. */
 export type MirrorRegion = {
   /** Destination start address of the mirror. */
   start: number;
@@ -106,7 +111,7 @@ export type MirrorRegion = {
 export type MemoryLayout = {
   /** Direct regions copied from ROM/RAM/zero. */
   regions?: MemoryRegion[];
-  /** Mirrors that duplicate an initialized span into another address range. */
+  /** Mirrors that alias an initialized span at another address range. */
   mirrors?: MirrorRegion[];
   /** Optional minimum capacity for the unified memory buffer. */
   minimumCapacity?: number;
@@ -223,12 +228,27 @@ export interface System {
   /** Reads a block of memory into a new byte array. */
   readBytes(address: number, length: number): Uint8Array;
 
+  /**
+   * Like readBytes, but returns a live view of unified memory when the block is contiguous.
+   * The view must be treated as read-only and goes stale once the CPU runs again.
+   */
+  peekBytes(address: number, length: number): Uint8Array;
+
   /** Writes a block of memory from a byte array. */
   writeBytes(address: number, data: Uint8Array): void;
 
   /** Returns a snapshot of the current CPU register values. */
   getRegisters(): CpuRegisters;
 
+  /**
+   * All registers from one native call, indexed by M68kRegister (D0 through PPC).
+   * The array is a shared view that the next call overwrites; copy it to keep it.
+   */
+  registerView(): Uint32Array;
+
+  /** Sets D0-D7, A0-A7, PC, SR and PPC from an array laid out like registerView(). */
+  setRegisters(regs: ArrayLike<number>): void;
+
   /** Sets the value of a single CPU register. */
   setRegister<K extends keyof CpuRegisters>(register: K, value: number): void;
 
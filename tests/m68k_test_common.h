@@ -20,7 +20,7 @@ extern "C" {
     void clear_pc_hook_func();
     void reset_myfunc_state();
     void clear_regions();
-    void add_region(unsigned int start, unsigned int size, void* data);
+    int add_region(unsigned int start, unsigned int size, void* data);
 }
 
 /* Minimal base class with just memory management - no tracing overhead */
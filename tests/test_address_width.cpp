@@ -0,0 +1,89 @@
+// Tests for the configurable guest address width and sparse high pages
+
+#include "m68k_test_common.h"
+#include "m68k_regions.h"
+
+#include <vector>
+
+extern "C" {
+    unsigned int m68k_read_memory_16(unsigned int address);
+    unsigned int m68k_read_memory_32(unsigned int address);
+    void m68k_write_memory_32(unsigned int address, unsigned int value);
+}
+
+namespace {
+
+unsigned int status_read16(void* context, unsigned int offset)
+{
+    return *static_cast<unsigned int*>(context) + offset;
+}
+
+}  // namespace
+
+DECLARE_M68K_TEST(AddressWidthTest) {
+protected:
+    void OnTearDown() override {
+        clear_regions();
+        m68k_set_address_width(24);
+    }
+};
+
+TEST_F(AddressWidthTest, Default24BitAddressesWrap) {
+    std::vector<uint8_t> ram(0x1000, 0);
+    ASSERT_GT(add_region(0x60000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    EXPECT_EQ(m68k_get_address_width(), 24);
+    m68k_write_memory_32(0x01060010, 0xCAFEBABE);
+    EXPECT_EQ(m68k_read_memory_32(0x60010), 0xCAFEBABEu);
+    EXPECT_EQ(m68k_set_address_width(16), -1);
+}
+
+TEST_F(AddressWidthTest, SparseHighRegionsAt32Bits) {
+    std::vector<uint8_t> high(0x2000, 0);
+    std::vector<uint8_t> low(0x1000, 0);
+    unsigned int status = 0x100;
+    m68k_mmio_handlers_t handlers{};
+    handlers.read16 = status_read16;
+
+    ASSERT_EQ(m68k_set_address_width(32), 0);
+    ASSERT_GT(add_region(0x60000, static_cast<unsigned int>(low.size()), low.data()), 0);
+    ASSERT_GT(add_region(0x80000000u, static_cast<unsigned int>(high.size()), high.data()), 0);
+    ASSERT_GT(add_mmio_region(0xFF000000u, 0x100, &handlers, &status), 0);
+    ASSERT_GT(add_mirror_region(0x90000000u, 0x2000, 0x80000000u), 0);
+
+    m68k_write_memory_32(0x80001FFC, 0x12345678);
+    EXPECT_EQ(high[0x1FFC], 0x12);
+    EXPECT_EQ(m68k_read_memory_32(0x90001FFC), 0x12345678u) << "high mirror aliases";
+    EXPECT_EQ(m68k_read_memory_16(0xFF000010), 0x110u);
+
+    m68k_write_memory_32(0x01060010, 0xCAFEBABE);
+    EXPECT_EQ(low[0x10], 0) << "no 24-bit aliasing at width 32";
+
+    // Back at 24 bits the high region is unreachable and low addresses wrap again
+    ASSERT_EQ(m68k_set_address_width(24), 0);
+    m68k_write_memory_32(0x01060010, 0xCAFEBABE);
+    EXPECT_EQ(low[0x10], 0xCA);
+}
+
+TEST_F(AddressWidthTest, Executes68020CodeFromHighRegion) {
+    std::vector<uint8_t> code(0x1000, 0);
+    const uint8_t program[] = {
+        0x70, 0x2A,                     // moveq #42,d0
+        0x23, 0xC0, 0xFF, 0x00, 0x00, 0x00,  // move.l d0,$FF000000
+        0x60, 0xFE,                     // bra.s *
+    };
+    std::copy(std::begin(program), std::end(program), code.begin());
+    std::vector<uint8_t> high(0x1000, 0);
+
+    ASSERT_EQ(m68k_set_address_width(32), 0);
+    ASSERT_GT(add_region(0xC0000000u, static_cast<unsigned int>(code.size()), code.data()), 0);
+    ASSERT_GT(add_region(0xFF000000u, static_cast<unsigned int>(high.size()), high.data()), 0);
+
+    m68k_set_cpu_type(M68K_CPU_TYPE_68020);
+    m68k_pulse_reset();
+    m68k_set_reg(M68K_REG_PC, 0xC0000000u);
+    m68k_execute(100);
+
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D0), 42u);
+    EXPECT_EQ(high[3], 42);
+    m68k_set_cpu_type(M68K_CPU_TYPE_68000);
+}
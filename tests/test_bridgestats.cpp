@@ -0,0 +1,61 @@
+// Tests for memory bridge access-path counters
+
+#include "m68k_test_common.h"
+#include "m68k_bridgestats.h"
+
+extern "C" int add_region(unsigned int start, unsigned int size, void* data);
+
+DECLARE_M68K_TEST(BridgeStatsTest) {
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x3038);       // move.w $2000.w,d0
+        write_word(0x402, 0x2000);
+        write_word(0x404, 0x21C0);       // move.l d0,$3000.w
+        write_word(0x406, 0x3000);
+        write_word(0x408, 0x4E72);       // stop #$2700
+        write_word(0x40A, 0x2700);
+
+        region_data[0] = 0x12;
+        region_data[1] = 0x34;
+        add_region(0x2000, sizeof(region_data), region_data);
+
+        m68k_bridge_stats_reset();
+        m68k_set_reg(M68K_REG_PC, 0x400);
+    }
+
+    uint8_t region_data[0x100] = {};
+};
+
+TEST_F(BridgeStatsTest, CountsPathsAndSizes) {
+    m68k_execute(100);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D0) & 0xFFFF, 0x1234u);
+
+    const m68k_bridge_stats_t* stats = m68k_bridge_stats_ptr();
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_REGION][1], 1u);
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_REGION][0], 0u);
+    EXPECT_EQ(stats->writes[M68K_BRIDGE_PATH_LEGACY][2], 1u);
+    EXPECT_EQ(stats->writes[M68K_BRIDGE_PATH_REGION][2], 0u);
+    EXPECT_GT(stats->fetches[1], 0u);
+    EXPECT_GE(stats->reads[M68K_BRIDGE_PATH_LEGACY][1] + stats->reads[M68K_BRIDGE_PATH_LEGACY][2],
+              stats->fetches[1] + stats->fetches[2]) << "code is served by the legacy callback";
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_JS][1], 0u);
+
+    m68k_bridge_stats_reset();
+    EXPECT_EQ(m68k_bridge_stats_ptr()->fetches[1], 0u);
+}
+
+TEST_F(BridgeStatsTest, SlowPageHistogramSkipsRegions) {
+    EXPECT_EQ(m68k_bridge_track_slow_pages(4), -1);
+    ASSERT_EQ(m68k_bridge_track_slow_pages(12), 0);
+    m68k_execute(100);
+
+    uint32_t pages[4] = {};
+    uint32_t counts[4] = {};
+    ASSERT_EQ(m68k_bridge_slow_pages(pages, counts, 4), 2);
+    EXPECT_EQ(pages[0], 0x0000u) << "instruction fetches dominate";
+    EXPECT_EQ(pages[1], 0x3000u);
+    EXPECT_EQ(counts[1], 1u);
+
+    m68k_bridge_track_slow_pages(0);
+    EXPECT_EQ(m68k_bridge_slow_pages(pages, counts, 4), 0);
+}
@@ -0,0 +1,73 @@
+// Tests for the native shadow call stack
+
+#include "m68k_test_common.h"
+#include "m68k_callstack.h"
+
+DECLARE_M68K_TEST(CallstackTest) {
+protected:
+    void OnSetUp() override {
+        write_long(0x80, 0x600);             // TRAP #0 vector
+
+        write_word(0x400, 0x4EB9);           // jsr $500.l
+        write_long(0x402, 0x500);
+        write_word(0x406, 0x60FE);           // bra.s *
+        write_word(0x500, 0x610E);           // bsr.s $510
+        write_word(0x502, 0x4E75);           // rts
+        write_word(0x510, 0x4E40);           // trap #0
+        write_word(0x512, 0x4E75);           // rts
+        write_long(0x600, 0x4E722700);       // stop #$2700
+
+        write_word(0x700, 0x610E);           // bsr.s $710
+        write_long(0x702, 0x4E722700);       // stop #$2700
+        write_word(0x710, 0x610E);           // bsr.s $720
+        write_word(0x712, 0x4E75);           // rts
+        write_word(0x720, 0x4E75);           // rts
+
+        write_word(0x800, 0x610E);           // bsr.s $810
+        write_word(0x810, 0x2E7C);           // movea.l #$1000,a7 (longjmp)
+        write_long(0x812, 0x1000);
+        write_word(0x816, 0x610E);           // bsr.s $826
+        write_long(0x826, 0x4E722700);       // stop #$2700
+    }
+
+    void run_from(uint32_t pc) {
+        m68k_set_reg(M68K_REG_PC, pc);
+        m68k_execute(1000);
+    }
+};
+
+TEST_F(CallstackTest, TracksCallsAndExceptionEntry) {
+    run_from(0x400);
+    ASSERT_EQ(m68k_callstack_depth(), 3);
+
+    uint32_t trace[8] = {};
+    ASSERT_EQ(m68k_get_backtrace(trace, 8), 3);
+    EXPECT_EQ(trace[0], 0x512u);
+    EXPECT_EQ(trace[1], 0x502u);
+    EXPECT_EQ(trace[2], 0x406u);
+
+    m68k_callstack_frame_t frames[8] = {};
+    ASSERT_EQ(m68k_get_backtrace_frames(frames, 2), 2);
+    EXPECT_EQ(frames[0].kind, static_cast<uint32_t>(M68K_CALLSTACK_EXCEPTION));
+    EXPECT_EQ(frames[0].target, 0x600u);
+    EXPECT_EQ(frames[1].kind, static_cast<uint32_t>(M68K_CALLSTACK_CALL));
+    EXPECT_EQ(frames[1].target, 0x510u);
+    EXPECT_LT(frames[0].sp, frames[1].sp);
+    EXPECT_GT(frames[0].cycle, frames[1].cycle);
+}
+
+TEST_F(CallstackTest, ReturnsUnwindFrames) {
+    run_from(0x700);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x706u);
+    EXPECT_EQ(m68k_callstack_depth(), 0);
+}
+
+TEST_F(CallstackTest, StackPointerResetDropsDeadFrames) {
+    run_from(0x800);
+    uint32_t trace[8] = {};
+    ASSERT_EQ(m68k_get_backtrace(trace, 8), 1);
+    EXPECT_EQ(trace[0], 0x818u);
+
+    m68k_pulse_reset();
+    EXPECT_EQ(m68k_callstack_depth(), 0);
+}
@@ -0,0 +1,80 @@
+// Tests for the snapshot diff engine
+
+#include <gtest/gtest.h>
+#include "m68k_diff.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/* Byte-at-a-time reference for ranges with merge_gap 0 */
+std::vector<m68k_diff_range_t> reference_ranges(const std::vector<uint8_t>& a,
+                                                const std::vector<uint8_t>& b, uint32_t base)
+{
+    std::vector<m68k_diff_range_t> out;
+    for (uint32_t i = 0; i < a.size(); ++i) {
+        if (a[i] == b[i]) {
+            continue;
+        }
+        if (!out.empty() && out.back().start - base + out.back().length == i) {
+            out.back().length++;
+        } else {
+            out.push_back({base + i, 1});
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(DiffTest, FindsScatteredRangesLikeByteLoop) {
+    std::vector<uint8_t> a(1 << 20);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<uint8_t>(i * 31 + (i >> 9));
+    }
+    std::vector<uint8_t> b = a;
+    const uint32_t touched[] = {0, 15, 16, 31, 32, 33, 34, 4095, 4096, 70000, 70001, 70003,
+                                (1u << 20) - 1};
+    for (uint32_t offset : touched) {
+        b[offset] ^= 0x5A;
+    }
+
+    const auto expected = reference_ranges(a, b, 0x100000);
+    std::vector<m68k_diff_range_t> ranges(32);
+    const int count = m68k_diff_memory(a.data(), b.data(), static_cast<uint32_t>(a.size()),
+                                       0x100000, 0, ranges.data(), 32);
+    ASSERT_EQ(count, static_cast<int>(expected.size()));
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(ranges[i].start, expected[i].start) << "range " << i;
+        EXPECT_EQ(ranges[i].length, expected[i].length) << "range " << i;
+    }
+    EXPECT_GE(m68k_diff_impl_in_use(), M68K_DIFF_SCALAR);
+}
+
+TEST(DiffTest, MergesGapsAndReportsTruncation) {
+    std::vector<uint8_t> a(256, 0);
+    std::vector<uint8_t> b = a;
+    b[10] = b[13] = 1;          // gap of 2
+    b[100] = b[110] = 1;        // gap of 9
+
+    m68k_diff_range_t ranges[4] = {};
+    ASSERT_EQ(m68k_diff_memory(a.data(), b.data(), 256, 0, 2, ranges, 4), 3);
+    EXPECT_EQ(ranges[0].start, 10u);
+    EXPECT_EQ(ranges[0].length, 4u);
+    EXPECT_EQ(ranges[1].start, 100u);
+    EXPECT_EQ(ranges[1].length, 1u);
+
+    EXPECT_EQ(m68k_diff_memory(a.data(), b.data(), 256, 0, 16, ranges, 1), 2);
+    EXPECT_EQ(ranges[0].length, 4u);
+    EXPECT_EQ(m68k_diff_memory(a.data(), a.data(), 256, 0, 0, ranges, 4), 0);
+}
+
+TEST(DiffTest, RegisterIndices) {
+    const uint32_t before[4] = {1, 2, 3, 4};
+    const uint32_t after[4] = {1, 9, 3, 0};
+    uint32_t indices[4] = {};
+    ASSERT_EQ(m68k_diff_regs(before, after, 4, indices), 2);
+    EXPECT_EQ(indices[0], 1u);
+    EXPECT_EQ(indices[1], 3u);
+}
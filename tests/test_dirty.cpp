@@ -0,0 +1,93 @@
+// Tests for dirty page tracking
+
+#include "m68k_test_common.h"
+#include "m68k_dirty.h"
+#include "m68k_regions.h"
+
+#include <vector>
+
+extern "C" void m68k_write_memory_16(unsigned int address, unsigned int value);
+
+DECLARE_M68K_TEST(DirtyTest) {
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x21C0);       // move.l d0,$2000.w
+        write_word(0x402, 0x2000);
+        write_word(0x404, 0x31C0);       // move.w d0,$30FE.w
+        write_word(0x406, 0x30FE);
+        write_word(0x408, 0x4E72);       // stop #$2700
+        write_word(0x40A, 0x2700);
+    }
+
+    void OnTearDown() override {
+        clear_regions();
+    }
+};
+
+TEST_F(DirtyTest, DisabledByDefault) {
+    m68k_execute(100);
+    EXPECT_EQ(m68k_dirty_page_shift(), 0);
+    uint32_t pages[4] = {};
+    EXPECT_EQ(m68k_dirty_get_and_clear(0, 0x1000000, pages, 4), 0);
+    EXPECT_EQ(m68k_dirty_enable(7), -1);
+}
+
+TEST_F(DirtyTest, GuestWritesMarkPagesUntilCollected) {
+    ASSERT_EQ(m68k_dirty_enable(8), 0);
+    m68k_execute(100);
+
+    uint32_t pages[8] = {};
+    EXPECT_EQ(m68k_dirty_count(0, 0x1000000), 2u);
+    ASSERT_EQ(m68k_dirty_get_and_clear(0, 0x1000000, pages, 1), 1);
+    EXPECT_EQ(pages[0], 0x2000u);
+    ASSERT_EQ(m68k_dirty_get_and_clear(0x3000, 0x100, pages, 8), 1);
+    EXPECT_EQ(pages[0], 0x3000u);
+    EXPECT_EQ(m68k_dirty_get_and_clear(0, 0x1000000, pages, 8), 0);
+}
+
+TEST_F(DirtyTest, DirectPagesBlockWritesAndRegionCounts) {
+    std::vector<uint8_t> ram(0x4000, 0);
+    const int handle = add_region(0x20000, static_cast<unsigned int>(ram.size()), ram.data());
+    ASSERT_GT(handle, 0);
+    ASSERT_EQ(m68k_dirty_enable(12), 0);
+    EXPECT_EQ(get_region_dirty_pages(handle), 0);
+
+    m68k_write_memory_16(0x21FFF, 0xABCD);       // straddles two 4 KB pages
+    const uint8_t block[0x10] = {1, 2, 3};
+    ASSERT_EQ(write_block(0x23000, sizeof(block), block), 0);
+    EXPECT_EQ(get_region_dirty_pages(handle), 3);
+    EXPECT_EQ(get_region_dirty_pages(handle + 1), -1);
+
+    uint32_t pages[8] = {};
+    ASSERT_EQ(m68k_dirty_get_and_clear(0x20000, 0x4000, pages, 8), 3);
+    EXPECT_EQ(pages[0], 0x21000u);
+    EXPECT_EQ(pages[1], 0x22000u);
+    EXPECT_EQ(pages[2], 0x23000u);
+    EXPECT_EQ(get_region_dirty_pages(handle), 0);
+}
+
+TEST_F(DirtyTest, MirrorWritesMarkTheTarget) {
+    std::vector<uint8_t> ram(0x10000, 0);
+    const int handle = add_region(0x100000, static_cast<unsigned int>(ram.size()), ram.data());
+    ASSERT_GT(handle, 0);
+    ASSERT_GT(add_mirror_region(0x200000, 0x10000, 0x100000), 0);
+    ASSERT_GT(add_mirror_region(0x300800, 0x800, 0x100800), 0);  // partial page: slow path
+    ASSERT_EQ(m68k_dirty_enable(12), 0);
+
+    m68k_write_memory_16(0x200010, 0x1234);
+    EXPECT_EQ(ram[0x10], 0x12);
+    EXPECT_EQ(m68k_dirty_count(0x100000, 0x1000), 1u);
+    EXPECT_EQ(get_region_dirty_pages(handle), 1);
+
+    m68k_dirty_clear();
+    m68k_write_memory_16(0x300810, 0x5678);
+    EXPECT_EQ(ram[0x810], 0x56);
+    EXPECT_EQ(m68k_dirty_count(0x100000, 0x1000), 1u);
+
+    m68k_dirty_clear();
+    const uint8_t block[4] = {9, 8, 7, 6};
+    ASSERT_EQ(write_block(0x205000, sizeof(block), block), 0);
+    uint32_t pages[4] = {};
+    ASSERT_EQ(m68k_dirty_get_and_clear(0x100000, 0x10000, pages, 4), 1);
+    EXPECT_EQ(pages[0], 0x105000u);
+}
@@ -0,0 +1,90 @@
+// Tests for the cached instruction-fetch page
+
+#include "m68k_test_common.h"
+#include "m68k_bridgestats.h"
+#include "m68k_fetchcache.h"
+#include "m68k_regions.h"
+
+#include <vector>
+
+extern "C" void m68k_write_memory_16(unsigned int address, unsigned int value);
+
+namespace {
+
+void put_word(std::vector<uint8_t>& buf, size_t offset, uint16_t value)
+{
+    buf[offset] = static_cast<uint8_t>(value >> 8);
+    buf[offset + 1] = static_cast<uint8_t>(value);
+}
+
+// moveq #n,d0; addq.l #1,d0; bra.s * (STOP would latch across runs)
+void put_program(std::vector<uint8_t>& buf, size_t offset, uint8_t n)
+{
+    put_word(buf, offset + 0, 0x7000 | n);   // moveq #n,d0
+    put_word(buf, offset + 2, 0x5280);       // addq.l #1,d0
+    put_word(buf, offset + 4, 0x60FE);       // bra.s *
+}
+
+}  // namespace
+
+DECLARE_M68K_TEST(FetchCacheTest) {
+protected:
+    void OnTearDown() override {
+        clear_regions();
+    }
+
+    unsigned int run_from(unsigned int pc) {
+        m68k_set_reg(M68K_REG_PC, pc);
+        m68k_execute(100);
+        return m68k_get_reg(NULL, M68K_REG_D0);
+    }
+};
+
+TEST_F(FetchCacheTest, DirectCodePageHitsCache) {
+    std::vector<uint8_t> code(0x1000, 0);
+    put_program(code, 0, 5);
+    ASSERT_GT(add_region(0x20000, static_cast<unsigned int>(code.size()), code.data()), 0);
+
+    m68k_bridge_stats_reset();
+    EXPECT_EQ(run_from(0x20000), 6u);
+    EXPECT_NE(m68k_fetch_cache.base, nullptr);
+    EXPECT_EQ(m68k_fetch_cache.page, 0x20000u);
+
+    const m68k_bridge_stats_t* stats = m68k_bridge_stats_ptr();
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_LEGACY][1], 0u);
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_REGION][1], stats->fetches[1])
+        << "hits still count as region fetches";
+    EXPECT_GE(stats->fetches[1], 3u);
+
+    // Code writes land in the same host page the cache reads
+    m68k_write_memory_16(0x20000, 0x7009);
+    EXPECT_EQ(run_from(0x20000), 10u);
+}
+
+TEST_F(FetchCacheTest, RemapAndClearInvalidate) {
+    std::vector<uint8_t> banks(0x2000, 0);
+    put_program(banks, 0x0000, 1);
+    put_program(banks, 0x1000, 7);
+    const int window = add_banked_region(0x30000, 0x1000, banks.data(),
+                                         static_cast<unsigned int>(banks.size()), M68K_REGION_ROM);
+    ASSERT_GT(window, 0);
+
+    EXPECT_EQ(run_from(0x30000), 2u);
+    ASSERT_EQ(remap_bank(window, 0x1000), 0);
+    EXPECT_EQ(m68k_fetch_cache.base, nullptr);
+    EXPECT_EQ(run_from(0x30000), 8u);
+
+    // Host memory behind the old page takes over once the region is gone
+    clear_regions();
+    EXPECT_EQ(m68k_fetch_cache.base, nullptr);
+    write_word(0x30000, 0x7003);             // moveq #3,d0
+    write_word(0x30002, 0x60FE);             // bra.s *
+    EXPECT_EQ(run_from(0x30000), 3u);
+}
+
+TEST_F(FetchCacheTest, HostBackedCodeIsNotCached) {
+    write_word(0x400, 0x7004);               // moveq #4,d0
+    write_word(0x402, 0x60FE);               // bra.s *
+    EXPECT_EQ(run_from(0x400), 4u);
+    EXPECT_EQ(m68k_fetch_cache.base, nullptr);
+}
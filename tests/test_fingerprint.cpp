@@ -0,0 +1,89 @@
+// Tests for execution fingerprinting and divergence search
+
+#include "m68k_test_common.h"
+#include "m68k_fingerprint.h"
+#include <vector>
+
+extern "C" void m68k_write_memory_32(unsigned int address, unsigned int value);
+
+DECLARE_M68K_TEST(FingerprintTest) {
+protected:
+    void OnSetUp() override {
+        // Count up in D0 and store it to $2000 each iteration
+        write_word(0x400, 0x7000);  // moveq #0,d0
+        write_word(0x402, 0x41F9);  // lea $2000.l,a0
+        write_long(0x404, 0x2000);
+        write_word(0x408, 0x5280);  // loop: addq.l #1,d0
+        write_word(0x40A, 0x2080);  // move.l d0,(a0)
+        write_word(0x40C, 0x60FA);  // bra.s loop
+    }
+
+    void OnTearDown() override {
+        m68k_fingerprint_disable();
+    }
+
+    /* Restart the program and fingerprint it from the first instruction */
+    void restart(uint32_t interval) {
+        m68k_pulse_reset();
+        ASSERT_EQ(m68k_fingerprint_enable(interval), 0);
+    }
+
+    void run_until(uint64_t instructions) {
+        m68k_fingerprint_break_at(instructions);
+        while (m68k_fingerprint_instructions() < instructions) {
+            m68k_execute(1000);
+        }
+        m68k_fingerprint_break_at(0);
+    }
+
+    std::vector<uint64_t> log() {
+        const uint64_t* data = m68k_fingerprint_data();
+        return std::vector<uint64_t>(data, data + m68k_fingerprint_count());
+    }
+};
+
+TEST_F(FingerprintTest, IdenticalRunsProduceIdenticalLogs) {
+    restart(10);
+    run_until(200);
+    EXPECT_EQ(m68k_fingerprint_instructions(), 200u);
+    ASSERT_EQ(m68k_fingerprint_count(), 20u);
+    const std::vector<uint64_t> first = log();
+
+    restart(10);
+    run_until(200);
+    EXPECT_EQ(log(), first);
+    EXPECT_EQ(m68k_fingerprint_find_divergence(first.data(), first.size()), -1);
+}
+
+TEST_F(FingerprintTest, BinarySearchFindsFirstDivergentWindow) {
+    restart(10);
+    run_until(200);
+    const std::vector<uint64_t> reference = log();
+
+    // Same program, but D0 is disturbed after instruction 57
+    restart(10);
+    run_until(57);
+    m68k_set_reg(M68K_REG_D0, m68k_get_reg(NULL, M68K_REG_D0) + 100);
+    run_until(200);
+
+    EXPECT_EQ(m68k_fingerprint_find_divergence(reference.data(), reference.size()), 5);
+    EXPECT_EQ(m68k_fingerprint_find_divergence(reference.data(), 5), -1);
+    EXPECT_EQ(m68k_fingerprint_find_divergence(nullptr, 0), -1);
+}
+
+TEST_F(FingerprintTest, MemoryWritesAreFingerprinted) {
+    restart(10);
+    run_until(30);
+    const uint64_t before = m68k_fingerprint_current();
+
+    restart(10);
+    run_until(30);
+    EXPECT_EQ(m68k_fingerprint_current(), before);
+
+    // A write with the same PC/opcode stream but different data differs
+    restart(10);
+    m68k_write_memory_32(0x2000, 1);
+    run_until(30);
+    EXPECT_NE(m68k_fingerprint_current(), before);
+    EXPECT_EQ(m68k_fingerprint_enable(0), -1);
+}
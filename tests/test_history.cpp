@@ -0,0 +1,89 @@
+// Tests for the last-branch record and PC history rings
+
+#include "m68k_test_common.h"
+#include "m68ktrace.h"
+#include "musashi_fault.h"
+
+DECLARE_M68K_TEST(HistoryTest) {
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x7202);  // moveq #2,d1
+        write_word(0x402, 0x6104);  // bsr.s $408
+        write_word(0x404, 0x60FA);  // bra.s $400
+        write_word(0x408, 0x5341);  // loop: subq.w #1,d1
+        write_word(0x40A, 0x66FC);  // bne.s loop
+        write_word(0x40C, 0x4E75);  // rts
+
+        write_long(0x10, 0x500);    // illegal instruction vector
+        write_word(0x500, 0x60FE);  // bra.s *
+        write_word(0x600, 0x6002);  // bra.s $604
+        write_word(0x604, 0x4AFC);  // illegal
+
+        m68k_history_clear();
+    }
+
+    void OnTearDown() override {
+        m68k_history_set_pc_tracking(0);
+        m68k_history_clear();
+    }
+
+    static const musashi_branch_record_t& branch(uint32_t i) {
+        return m68k_history_ptr()->branches[i % MUSASHI_HISTORY_SIZE];
+    }
+};
+
+TEST_F(HistoryTest, RecordsTakenBranchesOnly) {
+    m68k_execute(120);
+
+    const musashi_history_t* history = m68k_history_ptr();
+    EXPECT_EQ(history->size, static_cast<uint32_t>(MUSASHI_HISTORY_SIZE));
+    ASSERT_GE(history->branch_count, 4u);
+
+    EXPECT_EQ(branch(0).from, 0x402u);
+    EXPECT_EQ(branch(0).to, 0x408u);
+    EXPECT_EQ(branch(0).kind, static_cast<uint32_t>(M68K_TRACE_FLOW_CALL));
+    EXPECT_EQ(branch(1).from, 0x40Au);
+    EXPECT_EQ(branch(1).to, 0x408u);
+    // The second bne falls through and is not recorded
+    EXPECT_EQ(branch(2).from, 0x40Cu);
+    EXPECT_EQ(branch(2).to, 0x404u);
+    EXPECT_EQ(branch(2).kind, static_cast<uint32_t>(M68K_TRACE_FLOW_RETURN));
+    EXPECT_EQ(branch(3).from, 0x404u);
+    EXPECT_EQ(branch(3).to, 0x400u);
+
+    EXPECT_LT(branch(0).cycles, branch(1).cycles);
+    EXPECT_LT(branch(2).cycles, branch(3).cycles);
+    EXPECT_EQ(history->pc_count, 0u) << "PC ring is opt-in";
+}
+
+TEST_F(HistoryTest, RingWrapsAndPcTrackingIsOptional) {
+    m68k_history_set_pc_tracking(1);
+    m68k_execute(2000);
+
+    const musashi_history_t* history = m68k_history_ptr();
+    ASSERT_GT(history->branch_count, static_cast<uint32_t>(MUSASHI_HISTORY_SIZE));
+    // Each pass of the program records four branches, the last one the bra
+    const uint32_t last_bra = history->branch_count - 1 - history->branch_count % 4;
+    EXPECT_EQ(branch(last_bra).from, 0x404u);
+    EXPECT_EQ(branch(last_bra).to, 0x400u);
+
+    ASSERT_GT(history->pc_count, 6u);
+    EXPECT_EQ(history->pcs[0], 0x400u);
+    EXPECT_EQ(history->pcs[1], 0x402u);
+    EXPECT_EQ(history->pcs[2], 0x408u);
+    EXPECT_EQ(history->pcs[3], 0x40Au);
+}
+
+TEST_F(HistoryTest, FaultRecordPointsIntoHistory) {
+    m68k_fault_clear();
+    m68k_set_reg(M68K_REG_PC, 0x600);
+    m68k_execute(200);
+
+    const musashi_fault_record_t* fault = m68k_fault_record_ptr();
+    ASSERT_EQ(fault->active, 1u);
+    EXPECT_EQ(fault->kind, static_cast<uint32_t>(MUSASHI_FAULT_KIND_ILLEGAL_INSTRUCTION));
+    ASSERT_EQ(fault->branch_seq, 1u);
+    EXPECT_EQ(branch(fault->branch_seq - 1).from, 0x600u);
+    EXPECT_EQ(branch(fault->branch_seq - 1).to, 0x604u);
+    m68k_fault_clear();
+}
@@ -0,0 +1,66 @@
+// Tests for host callback cost accounting
+
+#include "m68k_test_common.h"
+#include "m68k_hookcost.h"
+#include <chrono>
+
+DECLARE_M68K_TEST(HookCostTest) {
+public:
+    /* One deliberately slow probe */
+    int OnPcHook(unsigned int pc) override {
+        if (pc == 0x402) {
+            const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+            while (std::chrono::steady_clock::now() < until) {
+            }
+        }
+        return M68kMinimalTestBase::OnPcHook(pc);
+    }
+
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x4E71);       // nop
+        write_word(0x402, 0x4E71);       // nop
+        write_word(0x404, 0x4E71);       // nop
+        write_word(0x406, 0x4E72);       // stop #$2700
+        write_word(0x408, 0x2700);
+    }
+};
+
+TEST_F(HookCostTest, DisabledByDefault) {
+    m68k_execute(100);
+
+    const m68k_hookcost_stats_t* stats = m68k_hookcost_stats_ptr();
+    EXPECT_EQ(stats->enabled, 0u);
+    EXPECT_EQ(stats->probe_pcs, 0u);
+    for (int i = 0; i < M68K_HOOK_KIND_COUNT; ++i) {
+        EXPECT_EQ(stats->kinds[i].latency.count, 0u) << "kind " << i;
+    }
+    EXPECT_EQ(m68k_hookcost_pc_ptr(0x402), nullptr);
+}
+
+TEST_F(HookCostTest, SlowProbeRanksFirst) {
+    m68k_hookcost_enable(1);
+    m68k_execute(100);
+    m68k_hookcost_enable(0);
+
+    const m68k_hookcost_stats_t* stats = m68k_hookcost_stats_ptr();
+    EXPECT_EQ(stats->kinds[M68K_HOOK_KIND_PC_HOOK].latency.count, pc_hooks.size());
+    EXPECT_EQ(stats->probe_pcs, pc_hooks.size());
+    EXPECT_GT(stats->kinds[M68K_HOOK_KIND_READ_MEM].latency.count, 0u);
+    EXPECT_EQ(stats->kinds[M68K_HOOK_KIND_JS_READ].latency.count, 0u);
+    EXPECT_GE(stats->kinds[M68K_HOOK_KIND_PC_HOOK].latency.max, 200000u);
+
+    uint32_t top[2] = {};
+    ASSERT_EQ(m68k_hookcost_top_pcs(top, 2), 2);
+    EXPECT_EQ(top[0], 0x402u);
+
+    const m68k_hook_cost_t* slow = m68k_hookcost_pc_ptr(0x402);
+    ASSERT_NE(slow, nullptr);
+    EXPECT_EQ(slow->latency.count, 1u);
+    EXPECT_GE(slow->latency.min, 200000u);
+    EXPECT_GE(slow->total_ns_lo, 200000u);
+
+    m68k_hookcost_reset();
+    EXPECT_EQ(m68k_hookcost_stats_ptr()->probe_pcs, 0u);
+    EXPECT_EQ(m68k_hookcost_pc_ptr(0x402), nullptr);
+}
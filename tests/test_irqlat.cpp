@@ -0,0 +1,79 @@
+// Tests for interrupt latency histograms
+
+#include "m68k_test_common.h"
+#include "m68k_irqlat.h"
+
+DECLARE_M68K_TEST(IrqLatencyTest) {
+public:
+    /* The handler's first instruction acknowledges the device */
+    int OnPcHook(unsigned int pc) override {
+        if (pc == 0x600) {
+            m68k_set_irq(0);
+            handler_entries++;
+        }
+        return M68kMinimalTestBase::OnPcHook(pc);
+    }
+
+protected:
+    void OnSetUp() override {
+        write_long(0x64, 0x600);         // level 1 autovector
+
+        write_word(0x400, 0x4E71);       // nop
+        write_word(0x402, 0x4E71);       // nop
+        write_word(0x404, 0x4E71);       // nop
+        write_word(0x406, 0x46FC);       // move #$2000,sr (unmask)
+        write_word(0x408, 0x2000);
+        write_word(0x40A, 0x4E71);       // loop: nop
+        write_word(0x40C, 0x60FC);       // bra.s loop
+
+        write_word(0x600, 0x4E71);       // nop
+        write_word(0x602, 0x4E71);       // nop
+        write_word(0x604, 0x4E73);       // rte
+
+        m68k_irqlat_reset();
+    }
+
+    int handler_entries = 0;
+};
+
+TEST_F(IrqLatencyTest, MaskedInterruptRecordsAckEntryAndHandlerTimes) {
+    m68k_set_irq(1);
+    m68k_execute(1000);
+    ASSERT_EQ(handler_entries, 1);
+
+    const m68k_irq_level_stats_t* stats = m68k_irqlat_stats_ptr(1);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->ack.count, 1u);
+    EXPECT_EQ(stats->ack.min, 12u) << "three nops before the mask drops";
+    EXPECT_EQ(stats->ack.max, stats->ack.min);
+    EXPECT_EQ(stats->ack.p99, stats->ack.min);
+    EXPECT_EQ(stats->entry.count, 1u);
+    // The move to SR finishes and the autovector exception runs first
+    EXPECT_EQ(stats->entry.min, stats->ack.min + 16u + 44u);
+    EXPECT_EQ(stats->handler.count, 1u);
+    EXPECT_GT(stats->handler.min, 0u);
+
+    EXPECT_EQ(m68k_irqlat_stats_ptr(2)->ack.count, 0u);
+    EXPECT_EQ(m68k_irqlat_stats_ptr(0), nullptr);
+    EXPECT_EQ(m68k_irqlat_stats_ptr(8), nullptr);
+}
+
+TEST_F(IrqLatencyTest, RepeatedInterruptsAggregate) {
+    m68k_execute(100);  // unmask first
+    for (int i = 0; i < 10; ++i) {
+        m68k_set_irq(1);
+        m68k_execute(200);
+    }
+    ASSERT_EQ(handler_entries, 10);
+
+    const m68k_irq_level_stats_t* stats = m68k_irqlat_stats_ptr(1);
+    EXPECT_EQ(stats->ack.count, 10u);
+    EXPECT_EQ(stats->ack.max, 0u) << "taken on entry to m68k_execute";
+    EXPECT_EQ(stats->handler.count, 10u);
+    EXPECT_LE(stats->handler.min, stats->handler.avg);
+    EXPECT_LE(stats->handler.avg, stats->handler.max);
+    EXPECT_GE(stats->handler.p99, stats->handler.avg);
+
+    m68k_irqlat_reset();
+    EXPECT_EQ(m68k_irqlat_stats_ptr(1)->handler.count, 0u);
+}
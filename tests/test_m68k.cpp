@@ -3,7 +3,7 @@
 #include "m68k_test_common.h"
 
 extern "C" {
-    void add_region(unsigned int start, unsigned int size, void* data);
+    int add_region(unsigned int start, unsigned int size, void* data);
     void enable_printf_logging();
 }
 
@@ -0,0 +1,167 @@
+// Tests for memoized m68k_call_until_js_stop() calls
+
+#include "m68k_test_common.h"
+#include "m68k_memo.h"
+#include "m68k_dirty.h"
+
+extern "C" {
+    unsigned long long m68k_call_until_js_stop(unsigned int entry_pc, unsigned int timeslice);
+}
+
+namespace {
+constexpr unsigned int kChecksumPc = 0x600;
+constexpr uint32_t kTable = 0x2000;
+constexpr uint32_t kResult = 0x3000;
+}
+
+DECLARE_M68K_TEST(MemoTest) {
+protected:
+    void OnSetUp() override {
+        // Read-sets must lie in direct region pages
+        add_region(0, static_cast<unsigned int>(memory.size()), memory.data());
+
+        // Sum 8 table bytes into D0 and store it
+        write_word(0x600, 0x7000);  // moveq #0,d0
+        write_word(0x602, 0x207C);  // movea.l #$2000,a0
+        write_long(0x604, kTable);
+        write_word(0x608, 0x7207);  // moveq #7,d1
+        write_word(0x60A, 0xD018);  // loop: add.b (a0)+,d0
+        write_word(0x60C, 0x51C9);  // dbra d1,loop
+        write_word(0x60E, 0xFFFC);
+        write_word(0x610, 0x23C0);  // move.l d0,$3000.l
+        write_long(0x612, kResult);
+        write_word(0x616, 0x4E75);  // rts
+
+        for (uint32_t i = 0; i < 8; ++i) {
+            memory[kTable + i] = static_cast<uint8_t>(i + 1);
+        }
+    }
+
+    void OnTearDown() override {
+        m68k_memo_disable_all();
+        m68k_dirty_enable(0);
+        clear_regions();
+    }
+
+    /* Call with identical argument registers every time */
+    unsigned long long call_checksum() {
+        m68k_set_reg(M68K_REG_D0, 0);
+        m68k_set_reg(M68K_REG_D1, 0);
+        m68k_set_reg(M68K_REG_A0, 0);
+        m68k_set_reg(M68K_REG_SR, 0x2700);
+        m68k_set_reg(M68K_REG_SP, 0x1000);
+        return m68k_call_until_js_stop(kChecksumPc, 1'000'000);
+    }
+};
+
+TEST_F(MemoTest, SecondCallIsAnsweredFromCache) {
+    m68k_memo_enable(kChecksumPc);
+
+    const unsigned long long cycles = call_checksum();
+    EXPECT_EQ(read_long(kResult), 36u);
+    const unsigned int d1 = m68k_get_reg(NULL, M68K_REG_D1);
+    const unsigned int a0 = m68k_get_reg(NULL, M68K_REG_A0);
+    const unsigned int sp = m68k_get_reg(NULL, M68K_REG_SP);
+    const unsigned int pc = m68k_get_reg(NULL, M68K_REG_PC);
+    const size_t hooks_after_first = pc_hooks.size();
+
+    write_long(kResult, 0);
+    EXPECT_EQ(call_checksum(), cycles);
+    EXPECT_EQ(read_long(kResult), 36u) << "write-set not applied";
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D0), 36u);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D1), d1);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_A0), a0);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_SP), sp);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), pc);
+    EXPECT_EQ(pc_hooks.size(), hooks_after_first) << "routine executed on a hit";
+
+    const m68k_memo_stats_t* stats = m68k_memo_stats_ptr(kChecksumPc);
+    EXPECT_EQ(stats->hits, 1u);
+    EXPECT_EQ(stats->misses, 1u);
+    EXPECT_EQ(stats->recorded, 1u);
+    EXPECT_EQ(stats->entries, 1u);
+}
+
+TEST_F(MemoTest, ChangedReadSetMissesAndInvalidationDropsEntries) {
+    m68k_memo_enable(kChecksumPc);
+    call_checksum();
+
+    memory[kTable + 3] = 100;
+    call_checksum();
+    EXPECT_EQ(read_long(kResult), 36u - 4u + 100u);
+
+    const m68k_memo_stats_t* stats = m68k_memo_stats_ptr(M68K_MEMO_ALL);
+    EXPECT_EQ(stats->hits, 0u);
+    EXPECT_EQ(stats->misses, 2u);
+    EXPECT_EQ(stats->entries, 2u);
+
+    // Writes outside every read-set keep the entries
+    m68k_memo_invalidate_range(0x4000, 0x100);
+    EXPECT_EQ(m68k_memo_stats_ptr(kChecksumPc)->entries, 2u);
+
+    m68k_memo_invalidate_range(kTable + 7, 1);
+    stats = m68k_memo_stats_ptr(kChecksumPc);
+    EXPECT_EQ(stats->entries, 0u);
+    EXPECT_EQ(stats->invalidated, 2u);
+
+    call_checksum();
+    EXPECT_EQ(m68k_memo_stats_ptr(kChecksumPc)->misses, 3u);
+}
+
+TEST_F(MemoTest, EntryPointsAreOptIn) {
+    call_checksum();
+    call_checksum();
+    EXPECT_EQ(m68k_memo_stats_ptr(M68K_MEMO_ALL)->entries, 0u);
+    EXPECT_EQ(m68k_memo_stats_ptr(M68K_MEMO_ALL)->misses, 0u);
+
+    m68k_memo_enable(kChecksumPc);
+    call_checksum();
+    m68k_memo_disable(kChecksumPc);
+    call_checksum();
+    EXPECT_EQ(m68k_memo_stats_ptr(kChecksumPc)->entries, 0u);
+    EXPECT_EQ(m68k_memo_stats_ptr(kChecksumPc)->hits, 0u);
+}
+
+TEST_F(MemoTest, FullSlotsEvictRatherThanInvalidate) {
+    m68k_memo_enable(kChecksumPc);
+
+    // Each call sees a different table, so every one records a new entry
+    for (uint32_t i = 0; i < 20; ++i) {
+        memory[kTable] = static_cast<uint8_t>(i);
+        call_checksum();
+    }
+
+    const m68k_memo_stats_t* stats = m68k_memo_stats_ptr(kChecksumPc);
+    EXPECT_EQ(stats->recorded, 20u);
+    EXPECT_EQ(stats->entries, 16u);
+    EXPECT_EQ(stats->evicted, 4u);
+    EXPECT_EQ(stats->invalidated, 0u);
+    EXPECT_EQ(m68k_memo_stats_ptr(M68K_MEMO_ALL)->evicted, 4u);
+}
+
+TEST_F(MemoTest, HitsWriteThroughTheBridge) {
+    m68k_memo_enable(kChecksumPc);
+    ASSERT_EQ(m68k_dirty_enable(12), 0);
+    call_checksum();
+    m68k_dirty_clear();
+
+    call_checksum();
+    EXPECT_EQ(m68k_memo_stats_ptr(kChecksumPc)->hits, 1u);
+    EXPECT_EQ(m68k_dirty_count(kResult, 4), 1u) << "hit did not mark its write-set dirty";
+}
+
+TEST_F(MemoTest, HostReadsAreNotCached) {
+    // Leave the table to the host read callback
+    clear_regions();
+    add_region(0, kTable, memory.data());
+    add_region(kResult, 0x1000, memory.data() + kResult);
+    m68k_memo_enable(kChecksumPc);
+
+    call_checksum();
+    call_checksum();
+    EXPECT_EQ(read_long(kResult), 36u);
+    const m68k_memo_stats_t* stats = m68k_memo_stats_ptr(kChecksumPc);
+    EXPECT_EQ(stats->hits, 0u);
+    EXPECT_EQ(stats->entries, 0u);
+    EXPECT_EQ(stats->rejected, 2u);
+}
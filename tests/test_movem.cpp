@@ -0,0 +1,140 @@
+// Tests for the MOVEM block transfer fast path
+
+#include "m68k_test_common.h"
+#include "m68k_bridgestats.h"
+#include "m68k_regions.h"
+#include "m68ktrace.h"
+
+#include <vector>
+
+extern "C" unsigned long long m68k_step_one(void);
+
+namespace {
+
+struct MemEvent {
+    m68k_trace_mem_type type;
+    uint32_t address;
+    uint32_t value;
+    uint8_t size;
+};
+
+std::vector<MemEvent> g_events;
+
+int record_mem(m68k_trace_mem_type type, uint32_t, uint32_t address, uint32_t value,
+               uint8_t size, uint64_t)
+{
+    g_events.push_back({type, address, value, size});
+    return 0;
+}
+
+}  // namespace
+
+DECLARE_M68K_TEST(MovemTest) {
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x48E7);       // movem.l d0-d7/a0-a6,-(a7)
+        write_word(0x402, 0xFFFE);
+        write_word(0x404, 0x4CDF);       // movem.l (a7)+,d0-d7/a0-a6
+        write_word(0x406, 0x7FFF);
+        write_word(0x408, 0x4C91);       // movem.w (a1),d2/d3
+        write_word(0x40A, 0x000C);
+        write_word(0x40C, 0x60FE);       // bra.s *
+        g_events.clear();
+    }
+
+    void OnTearDown() override {
+        m68k_trace_set_mem_enabled(0);
+        m68k_set_trace_mem_callback(nullptr);
+        m68k_trace_enable(0);
+        clear_regions();
+    }
+
+    // Saves and restores D0-D7/A0-A6 through a stack at 0x9000, then loads
+    // two sign-extended words from (A1)
+    void RunSaveRestore() {
+        for (int i = 0; i < 15; ++i) {
+            m68k_set_reg(static_cast<m68k_register_t>(M68K_REG_D0 + i), 0x01020304u * (i + 1));
+        }
+        m68k_set_reg(M68K_REG_A1, 0x8100);
+        m68k_set_reg(M68K_REG_A7, 0x9000);
+        m68k_step_one();
+        for (int i = 0; i < 15; ++i) {
+            m68k_set_reg(static_cast<m68k_register_t>(M68K_REG_D0 + i), 0);
+        }
+        m68k_step_one();
+        m68k_set_reg(M68K_REG_A1, 0x8100);
+        m68k_step_one();
+    }
+
+    void ExpectRestored(const uint8_t* stack) {
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_A7), 0x9000u);
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D0), 0x01020304u);
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_A6), 0x01020304u * 15);
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D2), 0xFFFF8000u);
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D3), 0x00001234u);
+        EXPECT_EQ(stack[0], 0x01) << "D0 lowest, big-endian";
+        EXPECT_EQ(stack[59], 0x3C);
+    }
+};
+
+TEST_F(MovemTest, DirectPageRunMatchesHostMemory) {
+    // Same program against host memory first
+    write_word(0x8100, 0x8000);
+    write_word(0x8102, 0x1234);
+    RunSaveRestore();
+    ExpectRestored(&memory[0x9000 - 60]);
+
+    std::vector<uint8_t> ram(0x1000, 0);
+    ram[0x100] = 0x80;
+    ram[0x102] = 0x12;
+    ram[0x103] = 0x34;
+    ASSERT_GT(add_region(0x8000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    m68k_set_reg(M68K_REG_PC, 0x400);
+    m68k_bridge_stats_reset();
+    RunSaveRestore();
+    ExpectRestored(&ram[0x1000 - 60]);
+
+    const m68k_bridge_stats_t* stats = m68k_bridge_stats_ptr();
+    EXPECT_EQ(stats->writes[M68K_BRIDGE_PATH_REGION][1], 30u) << "word pairs, as the slow path";
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_REGION][2], 15u);
+    EXPECT_EQ(stats->reads[M68K_BRIDGE_PATH_REGION][1], 2u) << "code runs from host memory";
+}
+
+TEST_F(MovemTest, TracingKeepsPerAccessEvents) {
+    std::vector<uint8_t> ram(0x1000, 0);
+    ram[0x100] = 0x80;
+    ram[0x102] = 0x12;
+    ram[0x103] = 0x34;
+    ASSERT_GT(add_region(0x8000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    m68k_trace_enable(1);
+    m68k_trace_set_mem_enabled(1);
+    m68k_set_trace_mem_callback(record_mem);
+
+    RunSaveRestore();
+    ExpectRestored(&ram[0x1000 - 60]);
+
+    ASSERT_EQ(g_events.size(), 30u + 15u + 2u);
+    EXPECT_EQ(g_events[0].type, M68K_TRACE_MEM_WRITE);
+    EXPECT_EQ(g_events[0].address, 0x9000u - 2) << "A6 low word first";
+    EXPECT_EQ(g_events[0].size, 2);
+    EXPECT_EQ(g_events[30].type, M68K_TRACE_MEM_READ);
+    EXPECT_EQ(g_events[30].address, 0x9000u - 60);
+    EXPECT_EQ(g_events[30].value, 0x01020304u);
+    EXPECT_EQ(g_events[45].value, 0x8000u);
+}
+
+TEST_F(MovemTest, RunsCrossingAPageTakeTheSlowPath) {
+    std::vector<uint8_t> ram(0x2000, 0);
+    ram[0x100] = 0x80;
+    ram[0x102] = 0x12;
+    ram[0x103] = 0x34;
+    ASSERT_GT(add_region(0x8000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    for (int i = 0; i < 15; ++i) {
+        m68k_set_reg(static_cast<m68k_register_t>(M68K_REG_D0 + i), 0x01020304u * (i + 1));
+    }
+    m68k_set_reg(M68K_REG_A7, 0x9010);   // stack straddles 0x9000
+    m68k_step_one();
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_A7), 0x9010u - 60);
+    EXPECT_EQ(ram[0x1010 - 60], 0x01);
+    EXPECT_EQ(ram[0x1010 - 1], 0x3C);
+}
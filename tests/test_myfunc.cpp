@@ -8,7 +8,7 @@ extern "C" {
     int my_initialize();
     void enable_printf_logging();
     void add_pc_hook_addr(unsigned int addr);
-    void add_region(unsigned int start, unsigned int size, void* data);
+    int add_region(unsigned int start, unsigned int size, void* data);
     void clear_regions();
     
     // Memory access functions
@@ -597,3 +597,29 @@ TEST_F(MyFuncTest, ExecutionWithRegions) {
     
     delete[] code;
 }
+
+TEST_F(MyFuncTest, AllRegsMatchSingleRegisterAccess) {
+    for (int i = 0; i < 16; ++i) {
+        m68k_set_reg(static_cast<m68k_register_t>(M68K_REG_D0 + i), 0x10000000u + i);
+    }
+    m68k_set_reg(M68K_REG_SR, 0x2714);
+    m68k_set_reg(M68K_REG_PPC, 0x3FE);
+
+    unsigned int regs[M68K_ALL_REGS_COUNT] = {};
+    m68k_get_all_regs(regs);
+    for (int i = 0; i < M68K_ALL_REGS_COUNT; ++i) {
+        EXPECT_EQ(regs[i], m68k_get_reg(NULL, static_cast<m68k_register_t>(i))) << "register " << i;
+    }
+
+    regs[M68K_REG_D5] = 0xCAFEF00D;
+    regs[M68K_REG_A7] = 0x2000;
+    regs[M68K_REG_SP] = 0x9999;          // ignored: A7 wins
+    regs[M68K_REG_PC] = 0x500;
+    regs[M68K_REG_SR] = 0x2701;
+    m68k_set_all_regs(regs);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D5), 0xCAFEF00Du);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_SP), 0x2000u);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x500u);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_SR), 0x2701u);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PPC), 0x3FEu);
+}
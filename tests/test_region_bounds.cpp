@@ -5,10 +5,15 @@
 #include <vector>
 
 extern "C" {
-    void add_region(unsigned int start, unsigned int size, void* data);
+    int add_region(unsigned int start, unsigned int size, void* data);
     void clear_regions();
     void m68k_write_memory_16(unsigned int address, unsigned int value);
     void m68k_write_memory_32(unsigned int address, unsigned int value);
+    unsigned int m68k_read_memory_16(unsigned int address);
+    unsigned int m68k_read_memory_32(unsigned int address);
+    unsigned int m68k_read_memory_8(unsigned int address);
+    void m68k_write_memory_8(unsigned int address, unsigned int value);
+    int add_region_swapped(unsigned int start, unsigned int size, void* data);
 }
 
 DECLARE_M68K_TEST(RegionBoundsTest) {
@@ -73,3 +78,81 @@ TEST_F(RegionBoundsTest, NoWritePastEndOnLong) {
     EXPECT_EQ(backing[sentinelIndex + 3], 0xDD);
 }
 
+
+// Accesses that straddle a 4 KB page inside one region are still big-endian
+TEST_F(RegionBoundsTest, AccessAcrossPageBoundary) {
+    std::vector<uint8_t> backing(0x3000, 0);
+    add_region(0x10000, static_cast<unsigned int>(backing.size()), backing.data());
+
+    m68k_write_memory_32(0x10FFE, 0x11223344);
+    EXPECT_EQ(backing[0xFFE], 0x11);
+    EXPECT_EQ(backing[0xFFF], 0x22);
+    EXPECT_EQ(backing[0x1000], 0x33);
+    EXPECT_EQ(backing[0x1001], 0x44);
+    EXPECT_EQ(m68k_read_memory_32(0x10FFE), 0x11223344u);
+    EXPECT_EQ(m68k_read_memory_16(0x10FFF), 0x2233u);
+}
+
+// The first region added wins wherever regions overlap, including pages the
+// later region covers wholly
+TEST_F(RegionBoundsTest, EarlierRegionWinsOverlap) {
+    std::vector<uint8_t> small(0x10, 0xAA);
+    std::vector<uint8_t> large(0x4000, 0xBB);
+    add_region(0x20800, static_cast<unsigned int>(small.size()), small.data());
+    add_region(0x20000, static_cast<unsigned int>(large.size()), large.data());
+
+    EXPECT_EQ(m68k_read_memory_16(0x20800), 0xAAAAu);
+    EXPECT_EQ(m68k_read_memory_16(0x20810), 0xBBBBu);
+    EXPECT_EQ(m68k_read_memory_16(0x21000), 0xBBBBu);
+
+    m68k_write_memory_16(0x20804, 0x1234);
+    EXPECT_EQ(small[4], 0x12);
+    EXPECT_EQ(large[0x804], 0xBB);
+
+    clear_regions();
+    EXPECT_EQ(m68k_read_memory_16(0x21000), 0u) << "cleared regions fall back to the host";
+}
+
+// Word-swapped regions look big-endian to the CPU on both the direct-page
+// and the region-scan paths
+TEST_F(RegionBoundsTest, SwappedRegionIsBigEndianToGuest) {
+    for (unsigned int size : {0x2000u, 0x10u}) {
+        std::vector<uint8_t> image(size, 0);
+        const uint8_t program[] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC};
+        std::copy(std::begin(program), std::end(program), image.begin());
+
+        clear_regions();
+        ASSERT_GT(add_region_swapped(0x40000, size, image.data()), 0);
+
+        EXPECT_EQ(m68k_read_memory_16(0x40000), 0x1234u) << "size " << size;
+        EXPECT_EQ(m68k_read_memory_32(0x40000), 0x12345678u);
+        EXPECT_EQ(m68k_read_memory_8(0x40001), 0x34u);
+        EXPECT_EQ(m68k_read_memory_16(0x40001), 0x3456u);
+        EXPECT_EQ(m68k_read_memory_32(0x40002), 0x56789ABCu);
+
+        m68k_write_memory_8(0x40003, 0xEF);
+        EXPECT_EQ(m68k_read_memory_16(0x40002), 0x56EFu);
+        m68k_write_memory_32(0x40004, 0xCAFEF00D);
+        EXPECT_EQ(m68k_read_memory_8(0x40004), 0xCAu);
+        EXPECT_EQ(m68k_read_memory_16(0x40006), 0xF00Du);
+    }
+
+    EXPECT_EQ(add_region_swapped(0x40001, 0x10, memory.data()), -1);
+    EXPECT_EQ(add_region_swapped(0x40000, 0x11, memory.data()), -1);
+}
+
+TEST_F(RegionBoundsTest, ExecutesFromSwappedRegion) {
+    std::vector<uint8_t> image(0x1000, 0);
+    const uint8_t program[] = {
+        0x70, 0x2A,              // moveq #42,d0
+        0x33, 0xC0, 0x00, 0x04, 0x00, 0x10,  // move.w d0,$40010
+        0x4E, 0x72, 0x27, 0x00,  // stop #$2700
+    };
+    std::copy(std::begin(program), std::end(program), image.begin());
+    ASSERT_GT(add_region_swapped(0x40000, static_cast<unsigned int>(image.size()), image.data()), 0);
+
+    m68k_set_reg(M68K_REG_PC, 0x40000);
+    m68k_execute(100);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_D0), 42u);
+    EXPECT_EQ(m68k_read_memory_16(0x40010), 42u);
+}
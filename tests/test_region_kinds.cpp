@@ -0,0 +1,352 @@
+// Tests for ROM, mirror and MMIO regions and removal by handle
+
+#include "m68k_test_common.h"
+#include "m68k_regions.h"
+#include "musashi_fault.h"
+
+#include <vector>
+
+extern "C" {
+    unsigned int m68k_read_memory_8(unsigned int address);
+    unsigned int m68k_read_memory_16(unsigned int address);
+    unsigned int m68k_read_memory_32(unsigned int address);
+    void m68k_write_memory_8(unsigned int address, unsigned int value);
+    void m68k_write_memory_16(unsigned int address, unsigned int value);
+    void m68k_write_memory_32(unsigned int address, unsigned int value);
+    int m68k_get_last_break_reason(void);
+    void m68k_reset_last_break_reason(void);
+}
+
+namespace {
+
+struct Device {
+    std::vector<std::pair<unsigned int, unsigned int>> writes;  // offset, value
+    unsigned int reads = 0;
+};
+
+unsigned int device_read8(void* context, unsigned int offset)
+{
+    static_cast<Device*>(context)->reads++;
+    return 0xA0 | (offset & 0x0F);
+}
+
+void device_write16(void* context, unsigned int offset, unsigned int value)
+{
+    static_cast<Device*>(context)->writes.emplace_back(offset, value);
+}
+
+}  // namespace
+
+DECLARE_M68K_TEST(RegionKindsTest) {
+protected:
+    void OnTearDown() override {
+        clear_regions();
+    }
+};
+
+TEST_F(RegionKindsTest, RomIgnoresWrites) {
+    std::vector<uint8_t> rom(0x2000, 0x11);
+    const int handle = add_rom_region(0x50000, static_cast<unsigned int>(rom.size()), rom.data(),
+                                      M68K_ROM_WRITE_IGNORE);
+    ASSERT_GT(handle, 0);
+
+    m68k_write_memory_16(0x50010, 0xBEEF);  // direct page
+    m68k_write_memory_32(0x51FFE, 0xBEEF);  // crosses the region end: host
+    EXPECT_EQ(m68k_read_memory_16(0x50010), 0x1111u);
+    EXPECT_EQ(rom[0x10], 0x11);
+    EXPECT_EQ(read_long(0x50010), 0u) << "ROM writes must not reach the host";
+
+    EXPECT_EQ(get_region_kind(0), M68K_REGION_ROM);
+    EXPECT_EQ(get_region_handle(0), handle);
+    EXPECT_EQ(add_rom_region(0x50000, 0x10, rom.data(), 7), -1);
+}
+
+TEST_F(RegionKindsTest, RomWriteFaultRaisesBusErrorWhileExecuting) {
+    std::vector<uint8_t> rom(0x1000, 0);
+    ASSERT_GT(add_rom_region(0x50000, static_cast<unsigned int>(rom.size()), rom.data(),
+                             M68K_ROM_WRITE_FAULT), 0);
+    write_long(0x08, 0x600);             // bus error vector
+    write_word(0x400, 0x33C0);           // move.w d0,$50000
+    write_long(0x402, 0x00050000);
+    write_word(0x406, 0x4E71);           // nop
+    write_word(0x600, 0x4E72);           // stop #$2700
+    write_word(0x602, 0x2700);
+
+    m68k_fault_clear();
+    m68k_write_memory_16(0x50000, 0x1234);  // outside execute: ignored
+    EXPECT_EQ(m68k_fault_record_ptr()->active, 0u);
+
+    m68k_execute(200);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x604u);
+    EXPECT_EQ(m68k_fault_record_ptr()->kind, static_cast<uint32_t>(MUSASHI_FAULT_KIND_BUS_ERROR));
+    EXPECT_EQ(rom[0], 0);
+}
+
+TEST_F(RegionKindsTest, MirrorsAliasTargets) {
+    std::vector<uint8_t> ram(0x2000, 0);
+    ASSERT_GT(add_region(0x60000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    ASSERT_GT(add_mirror_region(0x70000, 0x2000, 0x60000), 0);   // page aligned
+    ASSERT_GT(add_mirror_region(0x72010, 0x100, 0x60010), 0);    // small
+
+    m68k_write_memory_32(0x70100, 0xDEADBEEF);
+    EXPECT_EQ(m68k_read_memory_32(0x60100), 0xDEADBEEFu);
+    m68k_write_memory_16(0x60020, 0x5678);
+    EXPECT_EQ(m68k_read_memory_16(0x72020), 0x5678u);
+    m68k_write_memory_8(0x72011, 0x9A);
+    EXPECT_EQ(ram[0x11], 0x9A);
+
+    // Mirrors of host-backed space go through the host callbacks
+    ASSERT_GT(add_mirror_region(0x80000, 0x10, 0x90000), 0);
+    write_word(0x90004, 0x4242);
+    EXPECT_EQ(m68k_read_memory_16(0x80004), 0x4242u);
+
+    // Self-referencing chains are bounded
+    ASSERT_GT(add_mirror_region(0xA0000, 0x10, 0xA1000), 0);
+    ASSERT_GT(add_mirror_region(0xA1000, 0x10, 0xA0000), 0);
+    EXPECT_EQ(m68k_read_memory_16(0xA0000), 0u);
+    EXPECT_EQ(add_mirror_region(0xB0000, 0x10, 0xB0000), -1);
+}
+
+TEST_F(RegionKindsTest, FaultsThroughMirrorsLeaveOtherMirrorsWorking) {
+    std::vector<uint8_t> rom(0x1000, 0);
+    std::vector<uint8_t> ram(0x1000, 0);
+    ASSERT_GT(add_rom_region(0x60000, static_cast<unsigned int>(rom.size()), rom.data(),
+                             M68K_ROM_WRITE_FAULT), 0);
+    ASSERT_GT(add_region(0x62000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    ASSERT_GT(add_mirror_region(0x70010, 0x100, 0x60010), 0);   // slow path
+    ASSERT_GT(add_mirror_region(0x72010, 0x100, 0x62010), 0);
+
+    // Keep faulting through the ROM mirror; the handler drops the frame
+    // and jumps back, so the nested write never returns
+    write_long(0x08, 0x600);             // bus error vector
+    write_word(0x400, 0x33C0);           // again: move.w d0,$70010
+    write_long(0x402, 0x00070010);
+    write_word(0x406, 0x60F8);           // bra.s again
+    write_word(0x600, 0x4FF8);           // lea $1000.w,a7
+    write_word(0x602, 0x1000);
+    write_word(0x604, 0x4EF9);           // jmp again
+    write_long(0x606, 0x400);
+
+    m68k_execute(5000);
+    EXPECT_EQ(m68k_fault_record_ptr()->kind, static_cast<uint32_t>(MUSASHI_FAULT_KIND_BUS_ERROR));
+    EXPECT_EQ(rom[0x10], 0);
+
+    m68k_write_memory_16(0x72010, 0x1234);
+    EXPECT_EQ(ram[0x10], 0x12);
+    EXPECT_EQ(m68k_read_memory_16(0x72010), 0x1234u);
+}
+
+TEST_F(RegionKindsTest, MmioHandlersSplitMissingSizes) {
+    Device device;
+    m68k_mmio_handlers_t handlers{};
+    handlers.read8 = device_read8;
+    handlers.write16 = device_write16;
+    ASSERT_GT(add_mmio_region(0xC00000, 0x100, &handlers, &device), 0);
+
+    EXPECT_EQ(m68k_read_memory_8(0xC00003), 0xA3u);
+    EXPECT_EQ(m68k_read_memory_32(0xC00004), 0xA4A5A6A7u);
+    EXPECT_EQ(device.reads, 5u);
+
+    m68k_write_memory_32(0xC00010, 0x11223344);
+    m68k_write_memory_8(0xC00020, 0x55);  // no byte handler: dropped
+    ASSERT_EQ(device.writes.size(), 2u);
+    EXPECT_EQ(device.writes[0], std::make_pair(0x10u, 0x1122u));
+    EXPECT_EQ(device.writes[1], std::make_pair(0x12u, 0x3344u));
+    EXPECT_EQ(add_mmio_region(0xC00000, 0x100, nullptr, nullptr), -1);
+}
+
+TEST_F(RegionKindsTest, RemoveRegionByHandle) {
+    std::vector<uint8_t> front(0x1000, 0xAA);
+    std::vector<uint8_t> back(0x1000, 0xBB);
+    const int a = add_region(0x40000, 0x1000, front.data());
+    const int b = add_region(0x40000, 0x1000, back.data());
+    ASSERT_GT(a, 0);
+    ASSERT_GT(b, a);
+
+    EXPECT_EQ(m68k_read_memory_8(0x40000), 0xAAu);
+    EXPECT_EQ(remove_region(a), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x40000), 0xBBu);
+    EXPECT_EQ(remove_region(a), -1);
+    EXPECT_EQ(get_region_count(), 1u);
+    EXPECT_EQ(remove_region(b), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x40000), 0u);
+}
+
+TEST_F(RegionKindsTest, RemapBankSwapsPagesAndMirrorsFollow) {
+    std::vector<uint8_t> banks(0x4000);
+    for (size_t i = 0; i < banks.size(); ++i) {
+        banks[i] = static_cast<uint8_t>(i >> 12);  // bank number
+    }
+    const int window = add_banked_region(0x20000, 0x1000, banks.data(),
+                                         static_cast<unsigned int>(banks.size()), M68K_REGION_RAM);
+    ASSERT_GT(window, 0);
+    ASSERT_GT(add_mirror_region(0x30000, 0x1000, 0x20000), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x20010), 0u);
+
+    EXPECT_EQ(remap_bank(window, 0x2000), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x20010), 2u);
+    EXPECT_EQ(m68k_read_memory_8(0x30010), 2u) << "mirror follows the bank";
+    m68k_write_memory_16(0x30020, 0xCAFE);
+    EXPECT_EQ(banks[0x2020], 0xCA);
+    EXPECT_EQ(banks[0x0020], 0x00) << "bank 0 untouched";
+
+    EXPECT_EQ(remap_bank(window, 0x3001), -1);
+    EXPECT_EQ(m68k_read_memory_8(0x20010), 2u);
+    EXPECT_EQ(remap_bank(window + 100, 0), -1);
+
+    std::vector<uint8_t> plain(0x1000);
+    const int unbanked = add_region(0x10000, 0x1000, plain.data());
+    EXPECT_EQ(remap_bank(unbanked, 0), -1);
+    EXPECT_EQ(add_banked_region(0x40000, 0x2000, banks.data(), 0x1000, M68K_REGION_RAM), -1);
+    EXPECT_EQ(add_banked_region(0x40000, 0x1000, banks.data(), 0x4000, M68K_REGION_MMIO), -1);
+}
+
+TEST_F(RegionKindsTest, RomBankIgnoresWritesAfterRemap) {
+    std::vector<uint8_t> banks(0x2000, 0x33);
+    banks[0x1000] = 0x44;
+    const int window = add_banked_region(0x50000, 0x1000, banks.data(),
+                                         static_cast<unsigned int>(banks.size()), M68K_REGION_ROM);
+    ASSERT_GT(window, 0);
+    ASSERT_EQ(remap_bank(window, 0x1000), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x50000), 0x44u);
+    m68k_write_memory_8(0x50000, 0x99);
+    EXPECT_EQ(banks[0x1000], 0x44);
+}
+
+TEST_F(RegionKindsTest, BlockCopiesSpanDirectAndHostPages) {
+    std::vector<uint8_t> ram(0x2000, 0);
+    std::vector<uint8_t> swapped(0x1000, 0);
+    ASSERT_GT(add_region(0x40000, static_cast<unsigned int>(ram.size()), ram.data()), 0);
+    ASSERT_GT(add_region_swapped(0x42000, static_cast<unsigned int>(swapped.size()),
+                                 swapped.data()), 0);
+
+    // 0x41F00..0x43100: direct, swapped direct, then host memory
+    std::vector<uint8_t> pattern(0x1200);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        pattern[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    ASSERT_EQ(write_block(0x41F00, static_cast<unsigned int>(pattern.size()), pattern.data()), 0);
+    EXPECT_EQ(ram[0x1F00], pattern[0]);
+    EXPECT_EQ(m68k_read_memory_16(0x42000), (unsigned)((pattern[0x100] << 8) | pattern[0x101]));
+    EXPECT_EQ(memory[0x43000], pattern[0x1100]);
+
+    std::vector<uint8_t> back(pattern.size(), 0);
+    ASSERT_EQ(read_block(0x41F00, static_cast<unsigned int>(back.size()), back.data()), 0);
+    EXPECT_EQ(back, pattern);
+
+    EXPECT_EQ(read_block(0x40000, 4, nullptr), -1);
+    EXPECT_EQ(write_block(0x40000, 0, nullptr), 0);
+}
+
+TEST_F(RegionKindsTest, UnmappedOpenBusSkipsHostCallbacks) {
+    write_long(0x90000, 0x12345678);
+    ASSERT_EQ(set_unmapped_policy(0x90000, 1, M68K_UNMAPPED_OPEN_BUS), 0);
+    EXPECT_EQ(set_unmapped_policy(0x90000, 1, 9), -1);
+    EXPECT_EQ(get_last_unmapped_access(nullptr, nullptr), -1);
+
+    EXPECT_EQ(m68k_read_memory_16(0x90000), 0xFFFFu);
+    set_open_bus_value(0x4E71);
+    EXPECT_EQ(m68k_read_memory_8(0x90FFF), 0x71u);
+    EXPECT_EQ(m68k_read_memory_32(0x90010), 0x4E714E71u);
+    m68k_write_memory_16(0x90020, 0xBEEF);
+    EXPECT_EQ(read_long(0x90020), 0u) << "writes never reach the host";
+
+    unsigned int address = 0, size = 0;
+    EXPECT_EQ(get_last_unmapped_access(&address, &size), 1);
+    EXPECT_EQ(address, 0x90020u);
+    EXPECT_EQ(size, 2u);
+
+    // Neighbouring pages and regions are unaffected
+    EXPECT_EQ(m68k_read_memory_32(0x91000), 0u);
+    std::vector<uint8_t> ram(0x1000, 0x5A);
+    ASSERT_GT(add_region(0x90000, 0x100, ram.data()), 0);
+    EXPECT_EQ(m68k_read_memory_8(0x90000), 0x5Au);
+}
+
+TEST_F(RegionKindsTest, UnmappedBusErrorRecordsTheAccess) {
+    ASSERT_EQ(set_unmapped_default(M68K_UNMAPPED_BUS_ERROR), 0);
+    ASSERT_EQ(set_unmapped_policy(0, 0x10000, M68K_UNMAPPED_HOST), 0);  // vectors and code
+    write_long(0x08, 0x600);             // bus error vector
+    write_word(0x400, 0x3039);           // move.w $A00002,d0
+    write_long(0x402, 0x00A00002);
+    write_word(0x406, 0x4E71);           // nop
+    write_word(0x600, 0x4E72);           // stop #$2700
+    write_word(0x602, 0x2700);
+
+    m68k_fault_clear();
+    EXPECT_EQ(m68k_read_memory_16(0xA00002), 0xFFFFu) << "host reads see open bus";
+    EXPECT_EQ(m68k_fault_record_ptr()->active, 0u);
+
+    m68k_execute(200);
+    const musashi_fault_record_t* fault = m68k_fault_record_ptr();
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x604u);
+    EXPECT_EQ(fault->kind, static_cast<uint32_t>(MUSASHI_FAULT_KIND_BUS_ERROR));
+    EXPECT_EQ(fault->address, 0xA00002u);
+    EXPECT_EQ(fault->size, 2u);
+    EXPECT_EQ(fault->extra, 0u);
+}
+
+TEST_F(RegionKindsTest, UnmappedBreakStopsAfterTheInstruction) {
+    ASSERT_EQ(set_unmapped_policy(0xB0000, 0x1000, M68K_UNMAPPED_BREAK), 0);
+    write_word(0x400, 0x33C0);           // move.w d0,$B0000
+    write_long(0x402, 0x000B0000);
+    write_word(0x406, 0x4E71);           // nop
+    write_word(0x408, 0x60FE);           // bra.s *
+
+    m68k_reset_last_break_reason();
+    m68k_execute(1000);
+    EXPECT_EQ(m68k_get_last_break_reason(), 6);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x406u);
+    EXPECT_EQ(get_last_unmapped_access(nullptr, nullptr), 1);
+    m68k_reset_last_break_reason();
+}
+
+TEST_F(RegionKindsTest, WaitStatesChargeCyclesPerRegion) {
+    std::vector<uint8_t> rom(0x1000, 0);
+    const uint8_t program[] = {
+        0x30, 0x39, 0x00, 0x06, 0x00, 0x00,  // move.w $60000,d0
+        0x23, 0xC0, 0x00, 0x06, 0x00, 0x10,  // move.l d0,$60010
+        0x4E, 0x72, 0x27, 0x00,              // stop #$2700
+    };
+    std::copy(std::begin(program), std::end(program), rom.begin());
+    std::vector<uint8_t> ram(0x1000, 0);
+    ram[0] = 0x12;
+    const int code = add_rom_region(0x50000, static_cast<unsigned int>(rom.size()), rom.data(),
+                                    M68K_ROM_WRITE_IGNORE);
+    const int data = add_region(0x60000, static_cast<unsigned int>(ram.size()), ram.data());
+    const int mirror = add_mirror_region(0x70000, 0x1000, 0x60000);
+    ASSERT_GT(code, 0);
+    ASSERT_GT(data, 0);
+    ASSERT_GT(mirror, 0);
+
+    // One instruction per timeslice, stopping short of the STOP
+    auto run = [&]() {
+        m68k_pulse_reset();
+        m68k_execute(1);                 // reset cycles
+        m68k_set_reg(M68K_REG_PC, 0x50000);
+        return m68k_execute(1) + m68k_execute(1);
+    };
+    const int base = run();
+
+    ASSERT_EQ(set_region_wait_states(code, 1), 0);
+    ASSERT_EQ(set_region_wait_states(data, 3), 0);
+    EXPECT_EQ(set_region_wait_states(mirror, 1), -1);
+    EXPECT_EQ(set_region_wait_states(data + 100, 1), -1);
+    const int waited = run();
+
+    uint32_t code_lo = 0, data_lo = 0, hi = 1;
+    ASSERT_EQ(get_region_wait_cycles(code, &code_lo, &hi), 0);
+    EXPECT_EQ(hi, 0u);
+    ASSERT_EQ(get_region_wait_cycles(data, &data_lo, nullptr), 0);
+    EXPECT_EQ(data_lo, 9u) << "one word read and one long write at 3 each";
+    EXPECT_EQ(code_lo, 6u) << "six fetch bus cycles for the 12 code bytes";
+    EXPECT_EQ(waited - base, static_cast<int>(code_lo + data_lo));
+    EXPECT_EQ(ram[0x12], 0x12);
+
+    // Host accesses and mirrors of the region outside execute cost nothing
+    EXPECT_EQ(m68k_read_memory_16(0x70000), 0x1200u);
+    reset_wait_cycles();
+    ASSERT_EQ(get_region_wait_cycles(data, &data_lo, nullptr), 0);
+    EXPECT_EQ(data_lo, 0u);
+    EXPECT_EQ(get_region_wait_cycles(data + 100, &data_lo, nullptr), -1);
+}
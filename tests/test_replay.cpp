@@ -0,0 +1,167 @@
+// Tests for deterministic record/replay of host inputs
+
+#include "m68k_test_common.h"
+#include "m68k_regions.h"
+#include "m68k_replay.h"
+
+#include <vector>
+
+namespace {
+constexpr uint32_t kMmioAddr = 0x80000;
+constexpr uint32_t kHandlerAddr = 0x500;
+}
+
+DECLARE_M68K_TEST(ReplayTest) {
+public:
+    /* Hides the base accessor: MMIO reads return a value that changes every
+     * time, so a replay only matches if it comes from the log. */
+    int read_memory(unsigned int address, int size) {
+        if (address == kMmioAddr) {
+            mmio_reads++;
+            return live_mmio ? static_cast<int>((mmio_reads * 3 + 1) & 0xFFFF) : 0xDEAD;
+        }
+        return M68kMinimalTestBase<ReplayTest>::read_memory(address, size);
+    }
+
+    int mmio_reads = 0;
+    bool live_mmio = true;
+
+protected:
+    void OnSetUp() override {
+        write_word(0x400, 0x46FC);  // move.w #$2000,sr
+        write_word(0x402, 0x2000);
+        write_word(0x404, 0x3039);  // loop: move.w $80000.l,d0
+        write_long(0x406, kMmioAddr);
+        write_word(0x40A, 0xD240);  // add.w d0,d1
+        write_word(0x40C, 0x5282);  // addq.l #1,d2
+        write_word(0x40E, 0x60F4);  // bra.s loop
+
+        write_long(0x64, kHandlerAddr);  // level 1 autovector
+        write_word(kHandlerAddr, 0x5283);      // addq.l #1,d3
+        write_word(kHandlerAddr + 2, 0x4E73);  // rte
+    }
+
+    void OnTearDown() override {
+        m68k_replay_stop();
+        clear_regions();
+    }
+
+    struct Snapshot {
+        unsigned int d[4];
+        unsigned int pc;
+        unsigned int sp;
+    };
+
+    static Snapshot capture() {
+        Snapshot s{};
+        for (int i = 0; i < 4; ++i) {
+            s.d[i] = m68k_get_reg(NULL, static_cast<m68k_register_t>(M68K_REG_D0 + i));
+        }
+        s.pc = m68k_get_reg(NULL, M68K_REG_PC);
+        s.sp = m68k_get_reg(NULL, M68K_REG_SP);
+        return s;
+    }
+
+    /* Record a run sliced into small timeslices with two host IRQs */
+    std::vector<uint8_t> record(Snapshot& final_state, uint64_t& final_position) {
+        m68k_replay_start_recording();
+        for (int slice = 0; slice < 20; ++slice) {
+            if (slice == 5 || slice == 12) {
+                m68k_set_irq(1);
+            }
+            m68k_execute(37);
+        }
+        final_state = capture();
+        final_position = m68k_replay_position();
+        m68k_replay_stop();
+        const uint8_t* data = m68k_replay_log_data();
+        return std::vector<uint8_t>(data, data + m68k_replay_log_size());
+    }
+};
+
+TEST_F(ReplayTest, PlaybackReproducesRecordedRun) {
+    std::vector<uint8_t> context(m68k_context_size());
+    m68k_get_context(context.data());
+
+    Snapshot recorded{};
+    uint64_t recorded_position = 0;
+    const std::vector<uint8_t> log = record(recorded, recorded_position);
+    ASSERT_GT(mmio_reads, 0);
+    ASSERT_GT(recorded.d[3], 0u) << "IRQ handler never ran while recording";
+
+    // Restore the starting point; the device now returns different data and
+    // host IRQ/reset calls must be ignored.
+    m68k_set_context(context.data());
+    live_mmio = false;
+    ASSERT_EQ(m68k_replay_start_playback(log.data(), log.size()), 0);
+
+    m68k_set_irq(2);
+    m68k_execute(100000);
+
+    EXPECT_TRUE(m68k_replay_finished());
+    EXPECT_FALSE(m68k_replay_diverged());
+    EXPECT_EQ(m68k_replay_position(), recorded_position);
+
+    const Snapshot replayed = capture();
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(replayed.d[i], recorded.d[i]) << "D" << i;
+    }
+    EXPECT_EQ(replayed.pc, recorded.pc);
+    EXPECT_EQ(replayed.sp, recorded.sp);
+
+    // Once finished, further execution is held at the end of the log
+    EXPECT_EQ(m68k_execute(100), 0);
+}
+
+TEST_F(ReplayTest, PlaybackStopsOnDivergence) {
+    std::vector<uint8_t> context(m68k_context_size());
+    m68k_get_context(context.data());
+
+    Snapshot recorded{};
+    uint64_t recorded_position = 0;
+    const std::vector<uint8_t> log = record(recorded, recorded_position);
+
+    m68k_set_context(context.data());
+    m68k_set_reg(M68K_REG_PC, 0x404);  // skip the SR write: different fetch order
+    ASSERT_EQ(m68k_replay_start_playback(log.data(), log.size()), 0);
+    m68k_execute(100000);
+
+    EXPECT_TRUE(m68k_replay_diverged());
+    EXPECT_FALSE(m68k_replay_finished());
+    EXPECT_LT(m68k_replay_position(), recorded_position);
+}
+
+TEST_F(ReplayTest, RejectsInvalidLog) {
+    const uint8_t bogus[] = {'N', 'O', 'P', 'E', 1};
+    EXPECT_EQ(m68k_replay_start_playback(bogus, sizeof(bogus)), -1);
+    EXPECT_EQ(m68k_replay_start_playback(nullptr, 0), -1);
+    EXPECT_EQ(m68k_replay_get_mode(), M68K_REPLAY_OFF);
+}
+
+TEST_F(ReplayTest, MmioRegionReadsAreReplayedFromTheLog) {
+    // The same changing device, served by a native region handler
+    m68k_mmio_handlers_t handlers{};
+    handlers.read16 = [](void* context, unsigned int) -> unsigned int {
+        return static_cast<unsigned int>(static_cast<ReplayTest*>(context)->read_memory(kMmioAddr, 2));
+    };
+    ASSERT_GT(add_mmio_region(kMmioAddr, 0x100, &handlers, this), 0);
+
+    std::vector<uint8_t> context(m68k_context_size());
+    m68k_get_context(context.data());
+
+    Snapshot recorded{};
+    uint64_t recorded_position = 0;
+    const std::vector<uint8_t> log = record(recorded, recorded_position);
+    ASSERT_GT(mmio_reads, 0);
+
+    m68k_set_context(context.data());
+    live_mmio = false;
+    const int reads_before = mmio_reads;
+    ASSERT_EQ(m68k_replay_start_playback(log.data(), log.size()), 0);
+    m68k_execute(100000);
+
+    EXPECT_TRUE(m68k_replay_finished());
+    EXPECT_FALSE(m68k_replay_diverged());
+    EXPECT_EQ(mmio_reads, reads_before) << "device read during playback";
+    EXPECT_EQ(capture().d[1], recorded.d[1]);
+}
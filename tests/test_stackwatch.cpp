@@ -0,0 +1,93 @@
+// Tests for per-region stack high-water tracking
+
+#include "m68k_test_common.h"
+#include "m68k_stackwatch.h"
+
+DECLARE_M68K_TEST(StackWatchTest) {
+protected:
+    void OnSetUp() override {
+        // Push 65 longs onto the supervisor stack
+        write_word(0x400, 0x7040);       // moveq #64,d0
+        write_word(0x402, 0x2F00);       // loop: move.l d0,-(a7)
+        write_word(0x404, 0x51C8);       // dbra d0,loop
+        write_word(0x406, 0xFFFC);
+        write_long(0x408, 0x4E722700);   // stop #$2700
+
+        // Switch to a user stack and push twice
+        write_word(0x500, 0x207C);       // movea.l #$3400,a0
+        write_long(0x502, 0x3400);
+        write_word(0x506, 0x4E60);       // move.l a0,usp
+        write_word(0x508, 0x027C);       // andi.w #$dfff,sr
+        write_word(0x50A, 0xDFFF);
+        write_word(0x50C, 0x2F00);       // move.l d0,-(a7)
+        write_word(0x50E, 0x2F00);       // move.l d0,-(a7)
+        write_word(0x510, 0x60FE);       // bra.s *
+    }
+
+    void OnTearDown() override {
+        m68k_stack_clear_regions();
+    }
+};
+
+TEST_F(StackWatchTest, GuardStopsExecutionOnceAndRecordsHighWater) {
+    const int sv = m68k_stack_add_region(0xE00, 0x1000, 0xF00);
+    ASSERT_EQ(sv, 0);
+
+    m68k_execute(10000);
+    EXPECT_EQ(m68k_stack_take_guard_hit(), sv);
+    EXPECT_EQ(m68k_stack_take_guard_hit(), -1);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x404u) << "stopped right after the crossing push";
+
+    const m68k_stack_region_t* region = m68k_stack_region_ptr(sv);
+    EXPECT_EQ(region->low, 0xEFCu);
+    EXPECT_EQ(region->max_used, 0x104u);
+    EXPECT_EQ(region->guard_hits, 1u);
+
+    m68k_execute(10000);
+    EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x40Cu);
+    EXPECT_EQ(region->guard_hits, 1u);
+    EXPECT_EQ(m68k_stack_take_guard_hit(), -1);
+
+    m68k_stack_reset_marks();
+    EXPECT_EQ(region->low, 0x1000u);
+    EXPECT_EQ(region->max_used, 0u);
+}
+
+TEST_F(StackWatchTest, TracksEachStackSeparately) {
+    const int sv = m68k_stack_add_region(0xE00, 0x1000, 0);
+    const int user = m68k_stack_add_region(0x3000, 0x3400, 0x3100);
+    ASSERT_GE(user, 0);
+    EXPECT_EQ(m68k_stack_add_region(0x3200, 0x3800, 0), -1) << "overlap rejected";
+    EXPECT_EQ(m68k_stack_add_region(0x4000, 0x4000, 0), -1) << "empty range rejected";
+
+    m68k_set_reg(M68K_REG_PC, 0x500);
+    m68k_execute(200);
+
+    EXPECT_EQ(m68k_stack_region_ptr(user)->low, 0x33F8u);
+    EXPECT_EQ(m68k_stack_region_ptr(user)->max_used, 8u);
+    EXPECT_EQ(m68k_stack_region_ptr(user)->guard_hits, 0u);
+    EXPECT_EQ(m68k_stack_region_ptr(sv)->max_used, 0u);
+    EXPECT_EQ(m68k_stack_region_ptr(2), nullptr);
+}
+
+TEST_F(StackWatchTest, GuardRearmsWhenStackRisesAboveIt) {
+    // Reset the stack and push through the guard again, forever
+    write_word(0x600, 0x4FF8);       // again: lea $1000.w,a7
+    write_word(0x602, 0x1000);
+    write_word(0x604, 0x7040);       // moveq #64,d0
+    write_word(0x606, 0x2F00);       // loop: move.l d0,-(a7)
+    write_word(0x608, 0x51C8);       // dbra d0,loop
+    write_word(0x60A, 0xFFFC);
+    write_word(0x60C, 0x60F2);       // bra.s again
+
+    const int sv = m68k_stack_add_region(0xE00, 0x1000, 0xF00);
+    m68k_set_reg(M68K_REG_PC, 0x600);
+    for (uint32_t hits = 1; hits <= 3; ++hits) {
+        m68k_execute(10000);
+        EXPECT_EQ(m68k_stack_take_guard_hit(), sv);
+        EXPECT_EQ(m68k_stack_region_ptr(sv)->guard_hits, hits);
+        EXPECT_EQ(m68k_get_reg(NULL, M68K_REG_PC), 0x608u);
+    }
+    EXPECT_EQ(m68k_stack_region_ptr(sv)->low, 0xEFCu);
+    EXPECT_EQ(m68k_stack_region_ptr(sv)->max_used, 0x104u);
+}
@@ -0,0 +1,323 @@
+// Tests for checkpoint-based reverse execution
+
+#include "m68k_test_common.h"
+#include "m68k_callstack.h"
+#include "m68k_dirty.h"
+#include "m68k_regions.h"
+#include "m68k_timetravel.h"
+#include "m68ktrace.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr uint32_t kRamBase = 0x2000;
+}
+
+DECLARE_M68K_TEST(TimeTravelTest) {
+protected:
+    std::vector<uint8_t> ram;
+
+    void OnSetUp() override {
+        // Counter loop: D0 increments and is stored to region-backed RAM
+        write_word(0x400, 0x7000);  // moveq #0,d0
+        write_word(0x402, 0x5280);  // loop: addq.l #1,d0
+        write_word(0x404, 0x23C0);  // move.l d0,$2000.l
+        write_long(0x406, kRamBase);
+        write_word(0x40A, 0x60F6);  // bra.s loop
+
+        ram.assign(0x100, 0);
+        add_region(kRamBase, static_cast<unsigned int>(ram.size()), ram.data());
+    }
+
+    void OnTearDown() override {
+        m68k_timetravel_disable();
+        m68k_dirty_enable(0);
+        clear_regions();
+    }
+
+    uint32_t ram_counter() const {
+        return (ram[0] << 24) | (ram[1] << 16) | (ram[2] << 8) | ram[3];
+    }
+
+    static unsigned int reg(m68k_register_t r) {
+        return m68k_get_reg(NULL, r);
+    }
+
+    /* Run live with the given number of cycles per slice */
+    static void run(int slices) {
+        for (int i = 0; i < slices; ++i) {
+            m68k_execute(1000);
+        }
+    }
+};
+
+TEST_F(TimeTravelTest, SeekRestoresStateAndReturnsToPresent) {
+    ASSERT_EQ(m68k_timetravel_enable(200), 0);
+    run(5);
+
+    const uint64_t present = m68k_timetravel_position();
+    const unsigned int present_d0 = reg(M68K_REG_D0);
+    const uint32_t present_ram = ram_counter();
+    EXPECT_GT(m68k_timetravel_checkpoint_count(), 1u);
+
+    // Position 10 = moveq + three loop iterations
+    ASSERT_EQ(m68k_timetravel_seek(10), 0);
+    EXPECT_EQ(m68k_timetravel_position(), 10u);
+    EXPECT_EQ(reg(M68K_REG_D0), 3u);
+    EXPECT_EQ(ram_counter(), 3u);
+    EXPECT_EQ(reg(M68K_REG_PC), 0x402u);
+
+    ASSERT_EQ(m68k_timetravel_seek(present), 0);
+    EXPECT_EQ(reg(M68K_REG_D0), present_d0);
+    EXPECT_EQ(ram_counter(), present_ram);
+
+    ASSERT_EQ(m68k_timetravel_reverse_step(), 0);
+    EXPECT_EQ(m68k_timetravel_position(), present - 1);
+
+    // Futures beyond the recorded history are not reachable by seeking
+    EXPECT_EQ(m68k_timetravel_seek(present + 1), -1);
+
+    // Running forward replays to the present and then continues live
+    run(2);
+    EXPECT_GT(m68k_timetravel_position(), present);
+    EXPECT_GT(reg(M68K_REG_D0), present_d0);
+    EXPECT_GE(ram_counter() + 1, reg(M68K_REG_D0));
+    EXPECT_GT(m68k_timetravel_present(), present);
+}
+
+TEST_F(TimeTravelTest, ReverseContinueStopsAtLastWrite) {
+    ASSERT_EQ(m68k_timetravel_enable(200), 0);
+    run(3);
+    const uint64_t present = m68k_timetravel_position();
+
+    m68k_timetravel_add_watchpoint(kRamBase + 2, 2);
+    ASSERT_EQ(m68k_timetravel_reverse_continue(), 1);
+    const uint64_t hit = m68k_timetravel_position();
+    EXPECT_LT(hit, present);
+    EXPECT_EQ(reg(M68K_REG_PC), 0x40Au) << "stop follows the writing move.l";
+    EXPECT_EQ(ram_counter(), reg(M68K_REG_D0));
+
+    // The write before that is one loop iteration earlier
+    ASSERT_EQ(m68k_timetravel_reverse_continue(), 1);
+    EXPECT_EQ(m68k_timetravel_position(), hit - 3);
+    m68k_timetravel_clear_watchpoints();
+
+    m68k_timetravel_add_breakpoint(0x404);
+    ASSERT_EQ(m68k_timetravel_reverse_continue(), 1);
+    EXPECT_EQ(reg(M68K_REG_PC), 0x404u);
+    EXPECT_EQ(m68k_timetravel_position(), hit - 4);
+    m68k_timetravel_clear_breakpoints();
+
+    // Nothing to hit: run back to the start of history
+    EXPECT_EQ(m68k_timetravel_reverse_continue(), 0);
+    EXPECT_EQ(m68k_timetravel_position(), 0u);
+    EXPECT_EQ(reg(M68K_REG_PC), 0x400u);
+}
+
+TEST_F(TimeTravelTest, WatchpointsSetBeforeEnablingSeeDirectWrites) {
+    m68k_timetravel_add_watchpoint(kRamBase + 3, 1);
+    ASSERT_EQ(m68k_timetravel_enable(200), 0);
+    run(2);
+
+    EXPECT_EQ(m68k_timetravel_reverse_continue(), 1);
+    EXPECT_EQ(reg(M68K_REG_PC), 0x40Au);
+    m68k_timetravel_clear_watchpoints();
+}
+
+TEST_F(TimeTravelTest, SeekCycleStopsAtFirstBoundaryAtOrAfterTarget) {
+    ASSERT_EQ(m68k_timetravel_enable(500), 0);
+    run(4);
+
+    ASSERT_EQ(m68k_timetravel_seek_cycle(1234), 0);
+    const uint64_t cycle = m68k_timetravel_cycle();
+    EXPECT_GE(cycle, 1234u);
+    EXPECT_LT(cycle, 1234u + 30u);
+
+    EXPECT_EQ(m68k_timetravel_seek_cycle(1000000), -1);
+}
+
+TEST_F(TimeTravelTest, CheckpointsAreThinnedPastTheCap) {
+    ASSERT_EQ(m68k_timetravel_enable(10), 0);
+    run(20);
+
+    const unsigned int count = m68k_timetravel_checkpoint_count();
+    EXPECT_LE(count, 128u);
+    EXPECT_GT(count, 2u);
+
+    // The start of history survives thinning
+    ASSERT_EQ(m68k_timetravel_seek(10), 0);
+    EXPECT_EQ(reg(M68K_REG_D0), 3u);
+    EXPECT_EQ(ram_counter(), 3u);
+}
+
+TEST_F(TimeTravelTest, BankedRegionsRestoreEveryBankAndMarkDirty) {
+    clear_regions();
+    std::vector<uint8_t> backing(0x200, 0);
+    const int handle = add_banked_region(kRamBase, 0x100, backing.data(),
+                                         static_cast<unsigned int>(backing.size()), M68K_REGION_RAM);
+    ASSERT_GT(handle, 0);
+    ASSERT_EQ(m68k_dirty_enable(12), 0);
+
+    ASSERT_EQ(m68k_timetravel_enable(200), 0);
+    run(1);
+    ASSERT_EQ(remap_bank(handle, 0x100), 0);
+    run(1);
+    ASSERT_NE(backing[0x103], 0);
+    m68k_dirty_clear();
+
+    ASSERT_EQ(m68k_timetravel_seek(10), 0);
+    EXPECT_EQ(backing[0x103], 0) << "unmapped bank not rewound";
+    uint8_t window[4] = {};
+    read_block(kRamBase, sizeof(window), window);
+    EXPECT_EQ(window[3], 3u) << "bank offset not restored";
+    EXPECT_EQ(m68k_dirty_count(kRamBase, 0x100), 1u);
+}
+
+namespace {
+uint64_t g_traced_instructions = 0;
+uint64_t g_first_traced_cycle = 0;
+
+int count_instruction(uint32_t, uint16_t, uint64_t start_cycles, int) {
+    if (g_traced_instructions++ == 0) {
+        g_first_traced_cycle = start_cycles;
+    }
+    return 0;
+}
+}  // namespace
+
+TEST_F(TimeTravelTest, ExportedSegmentRetracesInAnotherInstance) {
+    ASSERT_EQ(m68k_timetravel_enable(300), 0);
+    run(3);
+    ASSERT_EQ(m68k_timetravel_checkpoint(), 0);
+    const unsigned int segments = m68k_timetravel_segment_count();
+    ASSERT_GT(segments, 1u);
+
+    const unsigned int end_d0 = reg(M68K_REG_D0);
+    const unsigned int end_pc = reg(M68K_REG_PC);
+    const uint32_t end_ram = ram_counter();
+
+    uint8_t* bundle = nullptr;
+    size_t bundle_size = 0;
+    ASSERT_EQ(m68k_timetravel_export_segment(segments - 1, &bundle, &bundle_size), 0);
+    EXPECT_EQ(m68k_timetravel_export_segment(segments, &bundle, &bundle_size), -1);
+
+    // Simulate a fresh worker: clobber CPU and RAM, then load the bundle
+    m68k_set_reg(M68K_REG_D0, 0);
+    m68k_set_reg(M68K_REG_PC, 0x400);
+    std::fill(ram.begin(), ram.end(), 0);
+    ASSERT_EQ(m68k_timetravel_load_segment(bundle, bundle_size), 0);
+    m68k_timetravel_free_segment(bundle);
+    EXPECT_FALSE(m68k_timetravel_is_enabled());
+
+    g_traced_instructions = 0;
+    m68k_set_trace_instr_callback(count_instruction);
+    m68k_trace_set_instr_enabled(1);
+    m68k_trace_enable(1);
+    const uint64_t start_position = m68k_timetravel_position();
+    const uint64_t start_cycle = m68k_get_total_cycles();
+
+    EXPECT_EQ(m68k_timetravel_run_segment(), 0);
+
+    m68k_trace_enable(0);
+    m68k_trace_set_instr_enabled(0);
+    m68k_set_trace_instr_callback(nullptr);
+
+    EXPECT_EQ(reg(M68K_REG_D0), end_d0);
+    EXPECT_EQ(reg(M68K_REG_PC), end_pc);
+    EXPECT_EQ(ram_counter(), end_ram);
+    EXPECT_EQ(g_traced_instructions, m68k_timetravel_position() - start_position);
+    EXPECT_GT(start_cycle, 0u);
+    EXPECT_EQ(g_first_traced_cycle, start_cycle);
+
+    const uint8_t bogus[] = {'M', '6', '8', 'S', 1, 0};
+    EXPECT_EQ(m68k_timetravel_load_segment(bogus, sizeof(bogus)), -1);
+}
+
+namespace {
+struct FlowEvent {
+    m68k_trace_flow_type type;
+    uint32_t dest;
+    uint64_t cycles;
+};
+std::vector<FlowEvent> g_flow_events;
+
+int record_flow(m68k_trace_flow_type type, uint32_t, uint32_t dest_pc, uint32_t,
+                const uint32_t*, const uint32_t*, uint64_t cycles) {
+    if (type == M68K_TRACE_FLOW_CALL || type == M68K_TRACE_FLOW_RETURN) {
+        g_flow_events.push_back(FlowEvent{type, dest_pc, cycles});
+    }
+    return 0;
+}
+}  // namespace
+
+TEST_F(TimeTravelTest, SegmentsStitchCallStacksAcrossJsr) {
+    // Main calls a short countdown subroutine forever
+    write_word(0x400, 0x4EB9);  // loop: jsr $500.l
+    write_long(0x402, 0x500);
+    write_word(0x406, 0x60F8);  // bra.s loop
+    write_word(0x500, 0x7203);  // moveq #3,d1
+    write_word(0x502, 0x5381);  // countdown: subq.l #1,d1
+    write_word(0x504, 0x66FC);  // bne.s countdown
+    write_word(0x506, 0x4E75);  // rts
+
+    // Checkpoints (never automatic here) split history inside the
+    // subroutine, so segment 1 starts and ends with the call open
+    ASSERT_EQ(m68k_timetravel_enable(1u << 30), 0);
+    const auto step_to = [](uint32_t pc) {
+        for (int i = 0; i < 100 && reg(M68K_REG_PC) != pc; ++i) {
+            m68k_execute(1);
+        }
+        ASSERT_EQ(reg(M68K_REG_PC), pc);
+    };
+    step_to(0x502);
+    ASSERT_EQ(m68k_timetravel_checkpoint(), 0);
+    step_to(0x406);
+    step_to(0x502);
+    ASSERT_EQ(m68k_timetravel_checkpoint(), 0);
+    ASSERT_EQ(m68k_timetravel_segment_count(), 2u);
+
+    // Loading a segment ends recording, so export both first
+    std::vector<std::vector<uint8_t>> bundles;
+    for (unsigned int index = 0; index < 2; ++index) {
+        uint8_t* bundle = nullptr;
+        size_t bundle_size = 0;
+        ASSERT_EQ(m68k_timetravel_export_segment(index, &bundle, &bundle_size), 0);
+        bundles.emplace_back(bundle, bundle + bundle_size);
+        m68k_timetravel_free_segment(bundle);
+    }
+
+    std::vector<FlowEvent> trace[2];
+    for (unsigned int index = 0; index < 2; ++index) {
+        m68k_callstack_clear();
+        ASSERT_EQ(m68k_timetravel_load_segment(bundles[index].data(), bundles[index].size()), 0);
+        EXPECT_EQ(m68k_callstack_depth(), static_cast<int>(index));
+
+        g_flow_events.clear();
+        m68k_set_trace_flow_callback(record_flow);
+        m68k_trace_set_flow_enabled(1);
+        m68k_trace_enable(1);
+        EXPECT_EQ(m68k_timetravel_run_segment(), 0);
+        m68k_trace_enable(0);
+        m68k_trace_set_flow_enabled(0);
+        m68k_set_trace_flow_callback(nullptr);
+        trace[index] = g_flow_events;
+    }
+
+    // Segment 0: the JSR, closed at the boundary
+    ASSERT_EQ(trace[0].size(), 2u);
+    EXPECT_EQ(trace[0][0].type, M68K_TRACE_FLOW_CALL);
+    EXPECT_EQ(trace[0][0].dest, 0x500u);
+    EXPECT_EQ(trace[0][1].type, M68K_TRACE_FLOW_RETURN);
+
+    // Segment 1: the open call reopened at the boundary, its RTS, the next
+    // JSR, and that call closed at the end
+    ASSERT_EQ(trace[1].size(), 4u);
+    EXPECT_EQ(trace[1][0].type, M68K_TRACE_FLOW_CALL);
+    EXPECT_EQ(trace[1][0].dest, 0x500u);
+    EXPECT_EQ(trace[1][0].cycles, trace[0][1].cycles);
+    EXPECT_EQ(trace[1][1].type, M68K_TRACE_FLOW_RETURN);
+    EXPECT_EQ(trace[1][2].type, M68K_TRACE_FLOW_CALL);
+    EXPECT_EQ(trace[1][3].type, M68K_TRACE_FLOW_RETURN);
+    EXPECT_EQ(m68k_callstack_depth(), 1);
+}